@@ -0,0 +1,2 @@
+# Calculs D-PHY sans instance, partagés par mipi_dsi et les drivers de panel DSI
+CODEOWNERS = ['@your_username']
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace esphome {
+namespace dsi_phy {
+
+// Timings PHY D-PHY, en périodes de bit au débit de la lane
+struct PhyTimings {
+  uint16_t hs_prepare;
+  uint16_t hs_zero;
+  uint16_t hs_trail;
+  uint16_t hs_exit;
+  uint16_t clk_prepare;
+  uint16_t clk_zero;
+  uint16_t clk_trail;
+  uint16_t clk_post;
+  uint16_t clk_pre;
+
+  // Passage LP -> HS -> LP d'une lane de données (une fois par ligne en mode burst)
+  uint32_t hs_transition_bits() const { return this->hs_prepare + this->hs_zero + this->hs_trail + this->hs_exit; }
+};
+
+// Timings pour un débit de lane (bps). Ces valeurs sont approximatives et
+// dépendent du PHY spécifique
+inline PhyTimings calculate_phy_timings(uint32_t bit_rate) {
+  const float bit_period_ns = 1000000000.0f / bit_rate;
+
+  PhyTimings timings;
+  timings.hs_prepare = (uint16_t) (40 / bit_period_ns);
+  timings.hs_zero = (uint16_t) (105 / bit_period_ns);
+  timings.hs_trail = (uint16_t) (std::max(8 * bit_period_ns, 60.0f) / bit_period_ns);
+  timings.hs_exit = (uint16_t) (100 / bit_period_ns);
+
+  timings.clk_prepare = (uint16_t) (38 / bit_period_ns);
+  timings.clk_zero = (uint16_t) (262 / bit_period_ns);
+  timings.clk_trail = (uint16_t) (60 / bit_period_ns);
+  timings.clk_post = (uint16_t) (60 / bit_period_ns);
+  timings.clk_pre = (uint16_t) (8 / bit_period_ns);
+  return timings;
+}
+
+}  // namespace dsi_phy
+}  // namespace esphome
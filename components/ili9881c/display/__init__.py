@@ -1,6 +1,9 @@
+import logging
+import math
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import display
+from esphome.components import display, sensor
 from esphome.const import (
     CONF_ID,
     CONF_MODEL,
@@ -13,18 +16,72 @@ from esphome.const import (
     CONF_INVERT_COLORS,
     CONF_AUTO_CLEAR_ENABLED,
     CONF_ROTATION,
+    CONF_LAMBDA,
+    CONF_TRIGGER_ID,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
 )
-from esphome import pins
+from esphome import automation, pins
 
 CONF_DC_PIN = "dc_pin"
 CONF_INIT_SEQUENCE = "init_sequence"
+CONF_INIT_SEQUENCE_ID = "init_sequence_id"
 CONF_DELAY = "delay"
 CONF_COLOR_ORDER = "color_order"
+CONF_PARTIAL_UPDATES = "partial_updates"
+CONF_PIXEL_FORMAT = "pixel_format"
+CONF_DITHERING = "dithering"
+CONF_DIRECT_FRAMEBUFFER = "direct_framebuffer"
+CONF_FRAMEBUFFERS = "framebuffers"
+CONF_ROTATION_MODE = "rotation_mode"
+CONF_FRAMEBUFFER_MEMORY = "framebuffer_memory"
+CONF_ASYNC_PRESENT = "async_present"
+
+# Instrumentation des trames
+CONF_STATS_INTERVAL = "stats_interval"
+CONF_RENDER_TIME = "render_time"
+CONF_CLEAR_TIME = "clear_time"
+CONF_FLUSH_TIME = "flush_time"
+CONF_WAIT_TIME = "wait_time"
+CONF_FPS = "fps"
+CONF_BYTES_PER_FRAME = "bytes_per_frame"
+CONF_BENCHMARK = "benchmark"
+
+# Contrôle de santé du panel et réinitialisation à chaud
+CONF_HEALTH_CHECK_INTERVAL = "health_check_interval"
+CONF_RECOVERIES = "recoveries"
+CONF_RECOVERY_TIME = "recovery_time"
+
+# Synchronisation sur le rafraîchissement du panel
+CONF_VSYNC_PRESENT = "vsync_present"
+CONF_VSYNC_DIVISOR = "vsync_divisor"
+CONF_ON_VSYNC = "on_vsync"
+
+# Détection des trames inchangées
+CONF_SKIP_UNCHANGED = "skip_unchanged"
+CONF_MAX_IDLE_INTERVAL = "max_idle_interval"
+
+# Calques
+CONF_BACKGROUND_LAYER = "background_layer"
+CONF_OVERLAY_LAYERS = "overlay_layers"
+CONF_ALPHA = "alpha"
+CONF_COLOR_KEY = "color_key"
+
+# Cache de glyphes (emplacements LRU, 0 : désactivé)
+CONF_GLYPH_CACHE_SIZE = "glyph_cache_size"
+
+# Rendu par bandes (lignes par bande, 0 : buffer de rendu complet)
+CONF_BAND_HEIGHT = "band_height"
+
+# Zones écrites par une bibliothèque graphique via flush_area(), sans buffer de rendu
+CONF_EXTERNAL_FLUSH = "external_flush"
 
 # Nouveaux paramètres MIPI DSI
 CONF_DATA_LANES = "data_lanes"
 CONF_LANE_BIT_RATE_MBPS = "lane_bit_rate_mbps"
 CONF_DPI_CLK_FREQ_MHZ = "dpi_clk_freq_mhz"
+CONF_TARGET_FPS = "target_fps"
 
 # Paramètres de timing MIPI DPI
 CONF_HSYNC = "hsync"
@@ -35,9 +92,14 @@ CONF_VBP = "vbp"
 CONF_VFP = "vfp"
 
 DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["sensor", "dsi_phy"]
+
+_LOGGER = logging.getLogger(__name__)
 
 ili9881c_ns = cg.esphome_ns.namespace("ili9881c")
 ILI9881C = ili9881c_ns.class_("ILI9881C", display.DisplayBuffer)
+ILI9881CRef = ILI9881C.operator("ref")
+VSyncTrigger = ili9881c_ns.class_("VSyncTrigger", automation.Trigger.template(cg.uint32))
 
 # Énumérations pour la rotation
 Rotation = ili9881c_ns.enum("Rotation")
@@ -48,6 +110,13 @@ ROTATIONS = {
     270: Rotation.ROTATION_270,
 }
 
+# Rotation appliquée à l'écriture des pixels ou au moment du flush
+RotationMode = ili9881c_ns.enum("RotationMode")
+ROTATION_MODES = {
+    "draw": RotationMode.ROTATION_MODE_DRAW,
+    "flush": RotationMode.ROTATION_MODE_FLUSH,
+}
+
 # Énumérations pour l'ordre des couleurs
 ColorOrder = ili9881c_ns.enum("ColorOrder")
 COLOR_ORDERS = {
@@ -55,6 +124,40 @@ COLOR_ORDERS = {
     "bgr": ColorOrder.COLOR_ORDER_BGR,
 }
 
+# Énumérations pour le format de pixel du framebuffer
+PixelFormat = ili9881c_ns.enum("PixelFormat")
+PIXEL_FORMATS = {
+    "rgb565": PixelFormat.PIXEL_FORMAT_RGB565,
+    "rgb666": PixelFormat.PIXEL_FORMAT_RGB666,
+    "rgb888": PixelFormat.PIXEL_FORMAT_RGB888,
+}
+
+# Mémoire du buffer de rendu : PSRAM puis interne (auto), ou imposée
+FramebufferMemory = ili9881c_ns.enum("FramebufferMemory")
+FRAMEBUFFER_MEMORIES = {
+    "auto": FramebufferMemory.FRAMEBUFFER_MEMORY_AUTO,
+    "psram": FramebufferMemory.FRAMEBUFFER_MEMORY_PSRAM,
+    "internal": FramebufferMemory.FRAMEBUFFER_MEMORY_INTERNAL,
+}
+
+# Bits transmis par pixel sur la liaison DSI
+PIXEL_FORMAT_BITS = {
+    "rgb565": 16,
+    "rgb666": 18,
+    "rgb888": 24,
+}
+
+# Planificateur de liaison, reflet de link_budget.h
+DSI_MAX_LANE_BIT_RATE_MBPS = 1500
+DSI_MIN_LANE_BIT_RATE_MBPS = 100
+DPI_MIN_CLK_FREQ_MHZ = 10
+DPI_MAX_CLK_FREQ_MHZ = 200
+DSI_LINE_OVERHEAD_BYTES = 6 + 2 * 4
+# Marge appliquée au débit de lane choisi automatiquement
+DSI_LANE_HEADROOM = 1.1
+DEFAULT_DPI_CLK_FREQ_MHZ = 80
+DEFAULT_LANE_BIT_RATE_MBPS = 1000
+
 MODELS = {
     "custom": {
         "width": 720,
@@ -62,6 +165,53 @@ MODELS = {
     },
 }
 
+# Durées moyennes publiées en millisecondes
+TIMING_SENSOR_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    icon="mdi:timer-outline",
+    accuracy_decimals=2,
+    state_class=STATE_CLASS_MEASUREMENT,
+)
+
+TIMING_SENSORS = [CONF_RENDER_TIME, CONF_CLEAR_TIME, CONF_FLUSH_TIME, CONF_WAIT_TIME]
+
+# Séquence flash : [len][cmd][data...] par commande, [0xFF][délai lo][délai hi] par délai
+INIT_DELAY_RECORD = 0xFF
+
+# Interface Pixel Format (COLMOD) selon le format du framebuffer
+COLMOD_VALUES = {
+    "rgb565": 0x55,
+    "rgb666": 0x66,
+    "rgb888": 0x77,
+}
+
+def default_init_sequence(pixel_format):
+    """Séquence ILI9881C standard utilisée si aucune n'est fournie."""
+    return [
+        [0x01],  # Software Reset
+        {CONF_DELAY: 100},
+        [0x11],  # Sleep Out
+        {CONF_DELAY: 120},
+        [0x3A, COLMOD_VALUES[pixel_format]],
+        # MADCTL n'est pas pris en compte en mode vidéo DPI : la rotation et l'ordre
+        # BGR sont appliqués par le pipeline de rendu, le panel reste en orientation native
+        [0x36, 0x00],  # Memory Access Control
+        [0x29],  # Display On
+        {CONF_DELAY: 20},
+    ]
+
+def encode_init_sequence(sequence):
+    """Encode la séquence en un flux d'octets interprété par le driver."""
+    encoded = []
+    for item in sequence:
+        if isinstance(item, dict):
+            delay_ms = item[CONF_DELAY]
+            encoded += [INIT_DELAY_RECORD, delay_ms & 0xFF, delay_ms >> 8]
+        else:
+            cmd, data = item[0], item[1:]
+            encoded += [len(data), cmd] + data
+    return encoded
+
 def validate_init_sequence(value):
     """Valide la séquence d'initialisation."""
     if not isinstance(value, list):
@@ -72,7 +222,9 @@ def validate_init_sequence(value):
         if isinstance(item, list):
             if len(item) < 1:
                 raise cv.Invalid("Command must have at least one byte")
-            validated.append([int(x) for x in item])
+            if len(item) - 1 >= INIT_DELAY_RECORD:
+                raise cv.Invalid(f"Command must have at most {INIT_DELAY_RECORD - 1} data bytes")
+            validated.append([cv.hex_uint8_t(x) for x in item])
         elif isinstance(item, dict):
             if CONF_DELAY in item:
                 delay_str = str(item[CONF_DELAY])
@@ -82,6 +234,8 @@ def validate_init_sequence(value):
                     delay_ms = int(float(delay_str[:-1]) * 1000)
                 else:
                     delay_ms = int(delay_str)
+                if not 0 <= delay_ms <= 0xFFFF:
+                    raise cv.Invalid("Delay must be between 0 and 65535 ms")
                 validated.append({CONF_DELAY: delay_ms})
             else:
                 raise cv.Invalid("Unknown command format in init_sequence")
@@ -90,7 +244,182 @@ def validate_init_sequence(value):
     
     return validated
 
-CONFIG_SCHEMA = display.BASIC_DISPLAY_SCHEMA.extend(
+def validate_framebuffers(config):
+    """Plusieurs framebuffers n'ont de sens qu'en rendu direct."""
+    if config[CONF_FRAMEBUFFERS] > 1 and not config[CONF_DIRECT_FRAMEBUFFER]:
+        raise cv.Invalid(
+            f"{CONF_FRAMEBUFFERS} > 1 requires {CONF_DIRECT_FRAMEBUFFER}: true"
+        )
+    if config[CONF_FRAMEBUFFER_MEMORY] != "auto" and config[CONF_DIRECT_FRAMEBUFFER]:
+        raise cv.Invalid(
+            f"{CONF_FRAMEBUFFER_MEMORY} applies to the render buffer; with "
+            f"{CONF_DIRECT_FRAMEBUFFER} the DPI driver allocates the frame buffers"
+        )
+    if config[CONF_ROTATION_MODE] == "flush" and config[CONF_DIRECT_FRAMEBUFFER]:
+        raise cv.Invalid(
+            f"{CONF_ROTATION_MODE}: flush renders into its own buffer and cannot be "
+            f"combined with {CONF_DIRECT_FRAMEBUFFER}"
+        )
+    if (
+        config[CONF_ASYNC_PRESENT]
+        and config[CONF_DIRECT_FRAMEBUFFER]
+        and config[CONF_FRAMEBUFFERS] < 2
+    ):
+        raise cv.Invalid(
+            f"{CONF_ASYNC_PRESENT} with {CONF_DIRECT_FRAMEBUFFER} needs {CONF_FRAMEBUFFERS} >= 2: "
+            f"the next frame would be drawn into the one being presented"
+        )
+    if config[CONF_PIXEL_FORMAT] == "rgb666" and config[CONF_DIRECT_FRAMEBUFFER]:
+        raise cv.Invalid(
+            f"{CONF_PIXEL_FORMAT}: rgb666 is rendered into a separate RGB888 buffer and "
+            f"cannot be combined with {CONF_DIRECT_FRAMEBUFFER}"
+        )
+    return config
+
+def validate_bands(config):
+    """Chaque bande est effacée et redessinée entièrement à chaque trame."""
+    if config[CONF_BAND_HEIGHT] == 0:
+        return config
+    for key, conflict in (
+        (CONF_DIRECT_FRAMEBUFFER, config[CONF_DIRECT_FRAMEBUFFER]),
+        (CONF_ROTATION_MODE, config[CONF_ROTATION_MODE] == "flush"),
+        (CONF_ASYNC_PRESENT, config[CONF_ASYNC_PRESENT]),
+        (CONF_SKIP_UNCHANGED, config[CONF_SKIP_UNCHANGED]),
+        (CONF_BACKGROUND_LAYER, config[CONF_BACKGROUND_LAYER]),
+        (CONF_OVERLAY_LAYERS, bool(config[CONF_OVERLAY_LAYERS])),
+    ):
+        if conflict:
+            raise cv.Invalid(f"{CONF_BAND_HEIGHT} cannot be combined with {key}")
+    if not config[CONF_AUTO_CLEAR_ENABLED]:
+        raise cv.Invalid(f"{CONF_BAND_HEIGHT} requires {CONF_AUTO_CLEAR_ENABLED}: true")
+    return config
+
+def validate_external_flush(config):
+    """flush_area() écrit seul dans le framebuffer DPI : rien n'est rendu par update()."""
+    if not config[CONF_EXTERNAL_FLUSH]:
+        return config
+    for key, conflict in (
+        (CONF_LAMBDA, CONF_LAMBDA in config),
+        (CONF_DIRECT_FRAMEBUFFER, config[CONF_DIRECT_FRAMEBUFFER]),
+        (CONF_ROTATION_MODE, config[CONF_ROTATION_MODE] == "flush"),
+        (CONF_ASYNC_PRESENT, config[CONF_ASYNC_PRESENT]),
+        (CONF_SKIP_UNCHANGED, config[CONF_SKIP_UNCHANGED]),
+        (CONF_BACKGROUND_LAYER, config[CONF_BACKGROUND_LAYER]),
+        (CONF_OVERLAY_LAYERS, bool(config[CONF_OVERLAY_LAYERS])),
+        (CONF_GLYPH_CACHE_SIZE, config[CONF_GLYPH_CACHE_SIZE] > 0),
+        (CONF_BAND_HEIGHT, config[CONF_BAND_HEIGHT] > 0),
+        (CONF_BENCHMARK, config[CONF_BENCHMARK]),
+    ):
+        if conflict:
+            raise cv.Invalid(f"{CONF_EXTERNAL_FLUSH} cannot be combined with {key}")
+    return config
+
+def dsi_transition_ns(lane_mbps):
+    """Passage LP -> HS -> LP d'une lane (dsi_phy::calculate_phy_timings)."""
+    bit_ns = 1000.0 / lane_mbps
+    return 40 + 105 + max(8 * bit_ns, 60) + 100
+
+def dsi_required_lane_mbps(width, h_total, bits_per_pixel, lanes, dpi_clk_mhz, lane_mbps):
+    """Débit par lane nécessaire pour transmettre une ligne active par période de ligne."""
+    line_ns = h_total * 1000.0 / dpi_clk_mhz
+    window_ns = line_ns - dsi_transition_ns(lane_mbps)
+    if window_ns <= 0:
+        return math.inf
+    line_bytes = (width * bits_per_pixel + 7) // 8 + DSI_LINE_OVERHEAD_BYTES
+    return line_bytes * 8.0 / lanes * 1000.0 / window_ns
+
+def plan_link(config):
+    """Choisit ou valide l'horloge DPI et le débit des lanes pour la cadence visée."""
+    if CONF_DIMENSIONS in config:
+        width = config[CONF_DIMENSIONS][CONF_WIDTH]
+        height = config[CONF_DIMENSIONS][CONF_HEIGHT]
+    else:
+        width = MODELS[config[CONF_MODEL]]["width"]
+        height = MODELS[config[CONF_MODEL]]["height"]
+    h_total = config[CONF_HSYNC] + config[CONF_HBP] + width + config[CONF_HFP]
+    v_total = config[CONF_VSYNC] + config[CONF_VBP] + height + config[CONF_VFP]
+    bits_per_pixel = PIXEL_FORMAT_BITS[config[CONF_PIXEL_FORMAT]]
+    lanes = config[CONF_DATA_LANES]
+    target_fps = config.get(CONF_TARGET_FPS)
+
+    if CONF_DPI_CLK_FREQ_MHZ not in config:
+        if target_fps is None:
+            config[CONF_DPI_CLK_FREQ_MHZ] = DEFAULT_DPI_CLK_FREQ_MHZ
+        else:
+            dpi_clk = max(math.ceil(h_total * v_total * target_fps / 1e6), DPI_MIN_CLK_FREQ_MHZ)
+            if dpi_clk > DPI_MAX_CLK_FREQ_MHZ:
+                raise cv.Invalid(
+                    f"{target_fps} Hz needs a {dpi_clk} MHz pixel clock for {h_total}x{v_total} "
+                    f"totals (max {DPI_MAX_CLK_FREQ_MHZ} MHz); lower {CONF_TARGET_FPS} or the porches",
+                    path=[CONF_TARGET_FPS],
+                )
+            config[CONF_DPI_CLK_FREQ_MHZ] = dpi_clk
+    dpi_clk = config[CONF_DPI_CLK_FREQ_MHZ]
+    refresh_rate = dpi_clk * 1e6 / (h_total * v_total)
+    if target_fps is not None and abs(refresh_rate - target_fps) > target_fps * 0.05:
+        raise cv.Invalid(
+            f"{CONF_DPI_CLK_FREQ_MHZ}: {dpi_clk} gives {refresh_rate:.1f} Hz, not the "
+            f"{target_fps} Hz of {CONF_TARGET_FPS}; remove one of them",
+            path=[CONF_DPI_CLK_FREQ_MHZ],
+        )
+
+    if CONF_LANE_BIT_RATE_MBPS not in config:
+        if target_fps is None:
+            lane_mbps = DEFAULT_LANE_BIT_RATE_MBPS
+        else:
+            # Le temps de passage LP/HS ne dépend quasiment pas du débit : on
+            # l'évalue au débit maximal puis on arrondit à 10 Mbps
+            required = dsi_required_lane_mbps(
+                width, h_total, bits_per_pixel, lanes, dpi_clk, DSI_MAX_LANE_BIT_RATE_MBPS
+            )
+            lane_mbps = max(
+                math.ceil(required * DSI_LANE_HEADROOM / 10) * 10, DSI_MIN_LANE_BIT_RATE_MBPS
+            )
+            if lane_mbps > DSI_MAX_LANE_BIT_RATE_MBPS:
+                lane_mbps = max(math.ceil(required / 10) * 10, DSI_MIN_LANE_BIT_RATE_MBPS)
+        config[CONF_LANE_BIT_RATE_MBPS] = lane_mbps
+    lane_mbps = config[CONF_LANE_BIT_RATE_MBPS]
+
+    required = dsi_required_lane_mbps(width, h_total, bits_per_pixel, lanes, dpi_clk, lane_mbps)
+    if required > DSI_MAX_LANE_BIT_RATE_MBPS:
+        raise cv.Invalid(
+            f"{width}x{height} {config[CONF_PIXEL_FORMAT]} at {refresh_rate:.1f} Hz needs "
+            f"{required:.0f} Mbps per lane on {lanes} lane(s), above the "
+            f"{DSI_MAX_LANE_BIT_RATE_MBPS} Mbps limit; add lanes, lower the refresh rate "
+            f"or use a smaller pixel format"
+        )
+    if required > lane_mbps:
+        raise cv.Invalid(
+            f"{CONF_LANE_BIT_RATE_MBPS}: {lane_mbps} is too low, {width}x{height} "
+            f"{config[CONF_PIXEL_FORMAT]} at {refresh_rate:.1f} Hz needs {required:.0f} Mbps "
+            f"per lane on {lanes} lane(s)",
+            path=[CONF_LANE_BIT_RATE_MBPS],
+        )
+
+    _LOGGER.info(
+        "ILI9881C link: %.1f Hz, DPI clock %d MHz, %d lane(s) at %d Mbps, %.0f%% used",
+        refresh_rate, dpi_clk, lanes, lane_mbps, required * 100.0 / lane_mbps,
+    )
+    return config
+
+def validate_layers(config):
+    """Les calques sont restaurés et recomposés à partir de l'effacement de chaque trame."""
+    uses_layers = config[CONF_BACKGROUND_LAYER] or config[CONF_OVERLAY_LAYERS]
+    if uses_layers and not config[CONF_AUTO_CLEAR_ENABLED]:
+        raise cv.Invalid(
+            f"{CONF_BACKGROUND_LAYER} and {CONF_OVERLAY_LAYERS} require {CONF_AUTO_CLEAR_ENABLED}: true"
+        )
+    return config
+
+# Calque superposé : opacité globale et couleur clé (0xRRGGBB) transparente
+OVERLAY_LAYER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_ALPHA, default="100%"): cv.percentage,
+        cv.Optional(CONF_COLOR_KEY): cv.All(cv.hex_int, cv.Range(min=0, max=0xFFFFFF)),
+    }
+)
+
+CONFIG_SCHEMA = cv.All(display.BASIC_DISPLAY_SCHEMA.extend(
     {
         cv.GenerateID(): cv.declare_id(ILI9881C),
         cv.Required(CONF_MODEL): cv.one_of(*MODELS, lower=True),
@@ -99,13 +428,67 @@ CONFIG_SCHEMA = display.BASIC_DISPLAY_SCHEMA.extend(
         cv.Optional(CONF_INVERT_COLORS, default=False): cv.boolean,
         cv.Optional(CONF_AUTO_CLEAR_ENABLED, default=True): cv.boolean,
         cv.Optional(CONF_ROTATION, default=0): cv.enum(ROTATIONS, int=True),
+        cv.Optional(CONF_ROTATION_MODE, default="draw"): cv.enum(ROTATION_MODES, lower=True),
         cv.Optional(CONF_COLOR_ORDER, default="rgb"): cv.enum(COLOR_ORDERS, lower=True),
         cv.Optional(CONF_INIT_SEQUENCE): validate_init_sequence,
+        cv.GenerateID(CONF_INIT_SEQUENCE_ID): cv.declare_id(cg.uint8),
+        cv.Optional(CONF_PARTIAL_UPDATES, default=True): cv.boolean,
+        cv.Optional(CONF_PIXEL_FORMAT, default="rgb888"): cv.enum(PIXEL_FORMATS, lower=True),
+        cv.Optional(CONF_DITHERING, default=False): cv.boolean,
+        cv.Optional(CONF_DIRECT_FRAMEBUFFER, default=False): cv.boolean,
+        cv.Optional(CONF_FRAMEBUFFERS, default=1): cv.int_range(min=1, max=3),
+        cv.Optional(CONF_FRAMEBUFFER_MEMORY, default="auto"): cv.enum(FRAMEBUFFER_MEMORIES, lower=True),
+        cv.Optional(CONF_ASYNC_PRESENT, default=False): cv.boolean,
+        
+        # Instrumentation : ligne de log et capteurs publiés à chaque intervalle
+        cv.Optional(CONF_STATS_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_BENCHMARK, default=False): cv.boolean,
+        cv.Optional(CONF_HEALTH_CHECK_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_VSYNC_PRESENT, default=False): cv.boolean,
+        cv.Optional(CONF_VSYNC_DIVISOR, default=0): cv.int_range(min=0, max=255),
+        cv.Optional(CONF_SKIP_UNCHANGED, default=False): cv.boolean,
+        cv.Optional(CONF_MAX_IDLE_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_BACKGROUND_LAYER, default=False): cv.boolean,
+        cv.Optional(CONF_OVERLAY_LAYERS, default=[]): cv.All(
+            cv.ensure_list(OVERLAY_LAYER_SCHEMA), cv.Length(max=4)
+        ),
+        cv.Optional(CONF_GLYPH_CACHE_SIZE, default=0): cv.int_range(min=0, max=1024),
+        cv.Optional(CONF_BAND_HEIGHT, default=0): cv.int_range(min=0, max=256),
+        cv.Optional(CONF_EXTERNAL_FLUSH, default=False): cv.boolean,
+        cv.Optional(CONF_ON_VSYNC): automation.validate_automation(
+            {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(VSyncTrigger)}
+        ),
+        cv.Optional(CONF_RENDER_TIME): TIMING_SENSOR_SCHEMA,
+        cv.Optional(CONF_CLEAR_TIME): TIMING_SENSOR_SCHEMA,
+        cv.Optional(CONF_FLUSH_TIME): TIMING_SENSOR_SCHEMA,
+        cv.Optional(CONF_WAIT_TIME): TIMING_SENSOR_SCHEMA,
+        cv.Optional(CONF_FPS): sensor.sensor_schema(
+            unit_of_measurement="fps",
+            icon="mdi:speedometer",
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_BYTES_PER_FRAME): sensor.sensor_schema(
+            unit_of_measurement="B",
+            icon="mdi:transfer",
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_RECOVERIES): sensor.sensor_schema(
+            icon="mdi:restart-alert",
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+        ),
+        cv.Optional(CONF_RECOVERY_TIME): TIMING_SENSOR_SCHEMA,
         
         # Paramètres MIPI DSI
         cv.Optional(CONF_DATA_LANES, default=2): cv.int_range(min=1, max=4),
-        cv.Optional(CONF_LANE_BIT_RATE_MBPS, default=1000): cv.int_range(min=100, max=2000),
-        cv.Optional(CONF_DPI_CLK_FREQ_MHZ, default=80): cv.int_range(min=10, max=200),
+        # Sans valeur explicite, déduits de target_fps par plan_link (sinon 1000 Mbps et 80 MHz)
+        cv.Optional(CONF_LANE_BIT_RATE_MBPS): cv.int_range(
+            min=DSI_MIN_LANE_BIT_RATE_MBPS, max=DSI_MAX_LANE_BIT_RATE_MBPS
+        ),
+        cv.Optional(CONF_DPI_CLK_FREQ_MHZ): cv.int_range(min=DPI_MIN_CLK_FREQ_MHZ, max=DPI_MAX_CLK_FREQ_MHZ),
+        cv.Optional(CONF_TARGET_FPS): cv.float_range(min=1, max=120),
         
         # Paramètres de timing DPI
         cv.Optional(CONF_HSYNC, default=40): cv.positive_int,
@@ -124,12 +507,18 @@ CONFIG_SCHEMA = display.BASIC_DISPLAY_SCHEMA.extend(
             }
         ),
     }
-)
+), validate_framebuffers, validate_layers, validate_bands, validate_external_flush, plan_link)
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await display.register_display(var, config)
 
+    if CONF_LAMBDA in config:
+        lambda_ = await cg.process_lambda(
+            config[CONF_LAMBDA], [(ILI9881CRef, "it")], return_type=cg.void
+        )
+        cg.add(var.set_writer(lambda_))
+
     model = config[CONF_MODEL]
     if CONF_DIMENSIONS in config:
         dimensions = config[CONF_DIMENSIONS]
@@ -149,7 +538,39 @@ async def to_code(config):
     cg.add(var.set_invert_colors(config[CONF_INVERT_COLORS]))
     cg.add(var.set_auto_clear_enabled(config[CONF_AUTO_CLEAR_ENABLED]))
     cg.add(var.set_rotation(config[CONF_ROTATION]))
+    cg.add(var.set_rotation_mode(config[CONF_ROTATION_MODE]))
     cg.add(var.set_color_order(config[CONF_COLOR_ORDER]))
+    cg.add(var.set_partial_updates(config[CONF_PARTIAL_UPDATES]))
+    cg.add(var.set_pixel_format(config[CONF_PIXEL_FORMAT]))
+    cg.add(var.set_dithering(config[CONF_DITHERING]))
+    cg.add(var.set_direct_framebuffer(config[CONF_DIRECT_FRAMEBUFFER]))
+    cg.add(var.set_num_framebuffers(config[CONF_FRAMEBUFFERS]))
+    cg.add(var.set_framebuffer_memory(config[CONF_FRAMEBUFFER_MEMORY]))
+    cg.add(var.set_async_present(config[CONF_ASYNC_PRESENT]))
+    cg.add(var.set_stats_interval(config[CONF_STATS_INTERVAL]))
+    cg.add(var.set_benchmark(config[CONF_BENCHMARK]))
+    cg.add(var.set_health_check_interval(config[CONF_HEALTH_CHECK_INTERVAL]))
+    cg.add(var.set_vsync_present(config[CONF_VSYNC_PRESENT]))
+    cg.add(var.set_vsync_divisor(config[CONF_VSYNC_DIVISOR]))
+    cg.add(var.set_skip_unchanged(config[CONF_SKIP_UNCHANGED]))
+    cg.add(var.set_max_idle_interval(config[CONF_MAX_IDLE_INTERVAL]))
+    cg.add(var.set_background_layer(config[CONF_BACKGROUND_LAYER]))
+    for layer in config[CONF_OVERLAY_LAYERS]:
+        color_key = layer.get(CONF_COLOR_KEY)
+        cg.add(var.add_overlay_layer(
+            int(round(layer[CONF_ALPHA] * 255)), color_key is not None, color_key or 0
+        ))
+    cg.add(var.set_glyph_cache_size(config[CONF_GLYPH_CACHE_SIZE]))
+    cg.add(var.set_band_height(config[CONF_BAND_HEIGHT]))
+    cg.add(var.set_external_flush(config[CONF_EXTERNAL_FLUSH]))
+    for conf in config.get(CONF_ON_VSYNC, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint32, "frame")], conf)
+
+    for key in TIMING_SENSORS + [CONF_FPS, CONF_BYTES_PER_FRAME, CONF_RECOVERIES, CONF_RECOVERY_TIME]:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, f"set_{key}_sensor")(sens))
 
     # Configuration des paramètres MIPI DSI
     cg.add(var.set_data_lanes(config[CONF_DATA_LANES]))
@@ -164,24 +585,10 @@ async def to_code(config):
     cg.add(var.set_vbp(config[CONF_VBP]))
     cg.add(var.set_vfp(config[CONF_VFP]))
 
-    # Gestion de la séquence d'initialisation
-    if CONF_INIT_SEQUENCE in config:
-        init_seq = config[CONF_INIT_SEQUENCE]
-        
-        cg.add(var.clear_init_sequence())
-        
-        for item in init_seq:
-            if isinstance(item, list):
-                cmd = item[0]
-                data = item[1:] if len(item) > 1 else []
-                cg.add(var.add_init_command(cmd, data))
-            elif isinstance(item, dict) and CONF_DELAY in item:
-                delay_ms = item[CONF_DELAY]
-                cg.add(var.add_init_delay(delay_ms))
-
-
-
-
-
-
-
+    # Séquence d'initialisation : flux d'octets constant, en flash
+    init_seq = config.get(CONF_INIT_SEQUENCE)
+    if init_seq is None:
+        init_seq = default_init_sequence(config[CONF_PIXEL_FORMAT])
+    encoded = encode_init_sequence(init_seq)
+    init_data = cg.progmem_array(config[CONF_INIT_SEQUENCE_ID], encoded)
+    cg.add(var.set_init_sequence(init_data, len(encoded)))
@@ -0,0 +1,177 @@
+#include "ili9881c.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+#include <vector>
+
+#ifdef USE_ESP32
+
+namespace esphome {
+namespace ili9881c {
+
+static const char *const TAG = "ili9881c.benchmark";
+
+// Motif 8x16 d'un caractère (un bit par pixel), pour simuler le rendu de texte
+static const uint8_t GLYPH_8X16[16] = {
+  0x00, 0x18, 0x3C, 0x66, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static void report(const char *name, uint32_t us, uint32_t pixels, uint8_t bpp) {
+  if (us == 0) {
+    us = 1;
+  }
+  ESP_LOGI(TAG, "  %-8s %8u us  %7.2f ns/px  %8.1f MB/s", name, (unsigned) us, us * 1000.0f / pixels,
+           (float) pixels * bpp / us);
+}
+
+void ILI9881C::run_benchmark_() {
+  if (this->band_height_ > 0) {
+    this->run_band_benchmark_();
+    return;
+  }
+  const int w = this->get_width_internal();
+  const int h = this->get_height_internal();
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  ESP_LOGI(TAG, "Rendering benchmark (%dx%d, %u bytes/px):", w, h, bpp);
+
+  // Effacement complet
+  static const int CLEAR_RUNS = 4;
+  uint32_t start = micros();
+  for (int i = 0; i < CLEAR_RUNS; i++) {
+    this->fill(Color(i * 60, 255 - i * 60, i * 30));
+  }
+  report("clear", micros() - start, CLEAR_RUNS * w * h, bpp);
+
+  // Rectangles pleins 64x64 couvrant l'écran
+  uint32_t pixels = 0;
+  start = micros();
+  for (int y = 0; y + 64 <= h; y += 64) {
+    for (int x = 0; x + 64 <= w; x += 64) {
+      this->filled_rectangle(x, y, 64, 64, Color(x & 0xFF, y & 0xFF, 0x80));
+      pixels += 64 * 64;
+    }
+  }
+  report("rects", micros() - start, pixels, bpp);
+
+  // Texte : glyphes dessinés pixel par pixel, comme le fait display::Font
+  pixels = 0;
+  start = micros();
+  for (int y = 0; y + 16 <= h; y += 32) {
+    for (int x = 0; x + 8 <= w; x += 8) {
+      for (int gy = 0; gy < 16; gy++) {
+        for (int gx = 0; gx < 8; gx++) {
+          if (GLYPH_8X16[gy] & (0x80 >> gx)) {
+            this->draw_pixel_at(x + gx, y + gy, Color(255, 255, 255));
+          }
+        }
+      }
+      pixels += 8 * 16;
+    }
+  }
+  report("text", micros() - start, pixels, bpp);
+
+  // Images : RGB565 big endian (format des images ESPHome) converti au format natif
+  static const int IMAGE_SIZE = 128;
+  std::vector<uint8_t> image(IMAGE_SIZE * IMAGE_SIZE * 2);
+  for (size_t i = 0; i < image.size(); i++) {
+    image[i] = i * 7;
+  }
+  pixels = 0;
+  start = micros();
+  for (int y = 0; y + IMAGE_SIZE <= h; y += IMAGE_SIZE) {
+    for (int x = 0; x + IMAGE_SIZE <= w; x += IMAGE_SIZE) {
+      this->blit(x, y, IMAGE_SIZE, IMAGE_SIZE, image.data(), IMAGE_SIZE * 2, BLIT_FORMAT_RGB565, true);
+      pixels += IMAGE_SIZE * IMAGE_SIZE;
+    }
+  }
+  report("blit", micros() - start, pixels, bpp);
+
+  // Transposé 90° par tuiles, indépendamment du mode de rotation configuré
+  static const int ROTATE_SIZE = 128;
+  std::vector<uint8_t> rotated(ROTATE_SIZE * ROTATE_SIZE * bpp);
+  const size_t stride = (size_t) this->get_buffer_width_() * bpp;
+  start = micros();
+  if (bpp == 2) {
+    rotate_block<2>(ROTATION_90, this->buffer_, stride, 0, 0, ROTATE_SIZE, ROTATE_SIZE, rotated.data(),
+                    ROTATE_SIZE * bpp, ROTATE_SIZE, ROTATE_SIZE);
+  } else {
+    rotate_block<3>(ROTATION_90, this->buffer_, stride, 0, 0, ROTATE_SIZE, ROTATE_SIZE, rotated.data(),
+                    ROTATE_SIZE * bpp, ROTATE_SIZE, ROTATE_SIZE);
+  }
+  report("rotate", micros() - start, ROTATE_SIZE * ROTATE_SIZE, bpp);
+
+  // Flush d'une trame complète (effacée au préalable pour ne rien laisser à l'écran)
+  this->fill(Color(0, 0, 0));
+  FrameJob job;
+  job.buffer = this->buffer_;
+  job.rects[0] = {0, 0, (uint16_t) this->get_buffer_width_(), (uint16_t) this->get_buffer_height_()};
+  job.count = 1;
+  job.scroll_offset = 0;
+  start = micros();
+  this->present_frame_(job);
+  report("flush", micros() - start, w * h, bpp);
+  this->flush_pending_ = false;
+}
+
+void ILI9881C::run_band_benchmark_() {
+  const int w = this->get_width_internal();
+  const int h = this->get_height_internal();
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  ESP_LOGI(TAG, "Band rendering benchmark (%dx%d, %u bytes/px):", w, h, bpp);
+
+  // Scène type rejouée pour chaque bande : rectangles, texte et images
+  static const int IMAGE_SIZE = 128;
+  std::vector<uint8_t> image(IMAGE_SIZE * IMAGE_SIZE * 2);
+  for (size_t i = 0; i < image.size(); i++) {
+    image[i] = i * 7;
+  }
+  auto scene = [this, w, h, &image]() {
+    for (int y = 0; y + 64 <= h; y += 128) {
+      for (int x = 0; x + 64 <= w; x += 128) {
+        this->filled_rectangle(x, y, 64, 64, Color(x & 0xFF, y & 0xFF, 0x80));
+      }
+    }
+    for (int y = 64; y + 16 <= h; y += 128) {
+      for (int x = 0; x + 8 <= w; x += 8) {
+        for (int gy = 0; gy < 16; gy++) {
+          for (int gx = 0; gx < 8; gx++) {
+            if (GLYPH_8X16[gy] & (0x80 >> gx)) {
+              this->draw_pixel_at(x + gx, y + gy, Color(255, 255, 255));
+            }
+          }
+        }
+      }
+    }
+    for (int y = 0; y + IMAGE_SIZE <= h; y += 2 * IMAGE_SIZE) {
+      this->blit(w - IMAGE_SIZE, y, IMAGE_SIZE, IMAGE_SIZE, image.data(), IMAGE_SIZE * 2, BLIT_FORMAT_RGB565, true);
+    }
+  };
+
+  // Bandes plus basses : moins de mémoire, plus de passes du writer
+  static const int BAND_RUNS = 4;
+  for (uint16_t lines = this->band_height_; lines > 0; lines /= 2) {
+    BandPassTimes total{};
+    const uint32_t start = micros();
+    for (int i = 0; i < BAND_RUNS; i++) {
+      const BandPassTimes times = this->render_bands_(lines, scene);
+      total.clear_us += times.clear_us;
+      total.render_us += times.render_us;
+      total.flush_us += times.flush_us;
+    }
+    const uint32_t frame_us = (micros() - start) / BAND_RUNS;
+    ESP_LOGI(TAG, "  %3u lines %7u bytes  clear %6u  render %6u  flush %6u  frame %6u us", lines,
+             (unsigned) (2 * this->get_buffer_width_() * lines * bpp), (unsigned) (total.clear_us / BAND_RUNS),
+             (unsigned) (total.render_us / BAND_RUNS), (unsigned) (total.flush_us / BAND_RUNS), (unsigned) frame_us);
+    if (lines < 8) {
+      break;
+    }
+  }
+
+  // Écran laissé noir
+  this->render_bands_(this->band_height_, []() {});
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
+
+#endif  // USE_ESP32
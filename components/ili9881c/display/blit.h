@@ -0,0 +1,159 @@
+#pragma once
+
+#include "pixel_format.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace ili9881c {
+
+// Formats source acceptés par ILI9881C::blit()
+enum BlitFormat : uint8_t {
+  BLIT_FORMAT_RGB565 = 0,
+  BLIT_FORMAT_RGB888 = 1,
+  BLIT_FORMAT_ARGB8888 = 2,
+  BLIT_FORMAT_GRAY8 = 3,
+};
+
+inline uint8_t blit_bytes_per_pixel(BlitFormat format) {
+  switch (format) {
+    case BLIT_FORMAT_RGB565: return 2;
+    case BLIT_FORMAT_RGB888: return 3;
+    case BLIT_FORMAT_ARGB8888: return 4;
+    case BLIT_FORMAT_GRAY8:
+    default: return 1;
+  }
+}
+
+// Convertit count pixels source en pixels natifs du framebuffer
+using RowConvertFn = void (*)(const uint8_t *src, uint8_t *dst, int count);
+
+// Décodage d'un pixel source ; BE : ordre des octets "big endian"
+// (RGB565 poids fort en tête, RGB888 = R,G,B, ARGB8888 = A,R,G,B en mémoire ;
+// sinon RGB565 natif, B,G,R et B,G,R,A comme un uint32_t little endian)
+template<BlitFormat SRC, bool BE>
+inline uint8_t decode_pixel(const uint8_t *s, uint8_t &r, uint8_t &g, uint8_t &b) {
+  if constexpr (SRC == BLIT_FORMAT_RGB565) {
+    uint16_t v = BE ? (s[0] << 8) | s[1] : s[0] | (s[1] << 8);
+    r = ((v >> 8) & 0xF8) | (v >> 13);
+    g = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+    b = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+    return 255;
+  } else if constexpr (SRC == BLIT_FORMAT_RGB888) {
+    r = BE ? s[0] : s[2];
+    g = s[1];
+    b = BE ? s[2] : s[0];
+    return 255;
+  } else if constexpr (SRC == BLIT_FORMAT_ARGB8888) {
+    r = BE ? s[1] : s[2];
+    g = BE ? s[2] : s[1];
+    b = BE ? s[3] : s[0];
+    return BE ? s[0] : s[3];
+  } else {
+    r = g = b = s[0];
+    return 255;
+  }
+}
+
+inline uint8_t blend_channel(uint8_t fg, uint8_t bg, uint8_t alpha) {
+  // (fg * a + bg * (255 - a)) / 255, arrondi
+  uint32_t v = fg * alpha + bg * (255 - alpha) + 128;
+  return (v + (v >> 8)) >> 8;
+}
+
+// Noyau générique : décodage, mélange alpha éventuel et encodage spécialisés à la compilation.
+// Boucle sans appel ni branche de format, vectorisable par le compilateur.
+template<BlitFormat SRC, bool BE, PixelFormat DST, bool INVERT, bool BGR>
+void convert_row(const uint8_t *__restrict src, uint8_t *__restrict dst, int count) {
+  constexpr uint8_t SB = SRC == BLIT_FORMAT_RGB565 ? 2 : SRC == BLIT_FORMAT_RGB888 ? 3
+                       : SRC == BLIT_FORMAT_ARGB8888 ? 4 : 1;
+  constexpr uint8_t DB = DST == PIXEL_FORMAT_RGB565 ? 2 : 3;
+  for (int i = 0; i < count; i++, src += SB, dst += DB) {
+    uint8_t r, g, b;
+    uint8_t a = decode_pixel<SRC, BE>(src, r, g, b);
+    if constexpr (SRC == BLIT_FORMAT_ARGB8888) {
+      if (a == 0) {
+        continue;
+      }
+      if (a != 255) {
+        uint8_t br, bg, bb;
+        read_pixel<DST, INVERT, BGR>(dst, br, bg, bb);
+        r = blend_channel(r, br, a);
+        g = blend_channel(g, bg, a);
+        b = blend_channel(b, bb, a);
+      }
+    }
+    write_pixel<DST, INVERT, BGR, false>(dst, 0, 0, Color(r, g, b));
+  }
+}
+
+// Même format en source et en destination : copie brute
+inline void copy_row_rgb565(const uint8_t *src, uint8_t *dst, int count) { memcpy(dst, src, (size_t) count * 2); }
+inline void copy_row_rgb888(const uint8_t *src, uint8_t *dst, int count) { memcpy(dst, src, (size_t) count * 3); }
+
+// RGB565 big endian -> natif : échange des octets deux pixels à la fois
+inline void swap_row_rgb565(const uint8_t *src, uint8_t *dst, int count) {
+  int i = 0;
+  for (; i + 2 <= count; i += 2, src += 4, dst += 4) {
+    uint32_t v;
+    memcpy(&v, src, 4);
+    v = ((v & 0x00FF00FFu) << 8) | ((v >> 8) & 0x00FF00FFu);
+    memcpy(dst, &v, 4);
+  }
+  if (i < count) {
+    dst[0] = src[1];
+    dst[1] = src[0];
+  }
+}
+
+template<BlitFormat SRC, bool BE, PixelFormat DST>
+RowConvertFn select_row_converter(bool invert, bool bgr) {
+  if (invert) {
+    return bgr ? &convert_row<SRC, BE, DST, true, true> : &convert_row<SRC, BE, DST, true, false>;
+  }
+  // Chemins directs lorsque la source est déjà au format natif
+  if constexpr (SRC == BLIT_FORMAT_RGB565 && DST == PIXEL_FORMAT_RGB565) {
+    if (!bgr) {
+      return BE ? &swap_row_rgb565 : &copy_row_rgb565;
+    }
+  }
+  if constexpr (SRC == BLIT_FORMAT_RGB888 && DST == PIXEL_FORMAT_RGB888) {
+    // R,G,B en mémoire pour un panel RGB, B,G,R pour un panel BGR
+    if (BE != bgr) {
+      return &copy_row_rgb888;
+    }
+  }
+  return bgr ? &convert_row<SRC, BE, DST, false, true> : &convert_row<SRC, BE, DST, false, false>;
+}
+
+template<BlitFormat SRC, bool BE>
+RowConvertFn select_row_converter(PixelFormat dst, bool invert, bool bgr) {
+  switch (dst) {
+    case PIXEL_FORMAT_RGB565: return select_row_converter<SRC, BE, PIXEL_FORMAT_RGB565>(invert, bgr);
+    case PIXEL_FORMAT_RGB666: return select_row_converter<SRC, BE, PIXEL_FORMAT_RGB666>(invert, bgr);
+    case PIXEL_FORMAT_RGB888:
+    default: return select_row_converter<SRC, BE, PIXEL_FORMAT_RGB888>(invert, bgr);
+  }
+}
+
+// Choisit le noyau de conversion pour un blit donné
+inline RowConvertFn select_row_converter(BlitFormat src, bool big_endian, PixelFormat dst, bool invert, bool bgr) {
+  switch (src) {
+    case BLIT_FORMAT_RGB565:
+      return big_endian ? select_row_converter<BLIT_FORMAT_RGB565, true>(dst, invert, bgr)
+                        : select_row_converter<BLIT_FORMAT_RGB565, false>(dst, invert, bgr);
+    case BLIT_FORMAT_RGB888:
+      return big_endian ? select_row_converter<BLIT_FORMAT_RGB888, true>(dst, invert, bgr)
+                        : select_row_converter<BLIT_FORMAT_RGB888, false>(dst, invert, bgr);
+    case BLIT_FORMAT_ARGB8888:
+      return big_endian ? select_row_converter<BLIT_FORMAT_ARGB8888, true>(dst, invert, bgr)
+                        : select_row_converter<BLIT_FORMAT_ARGB8888, false>(dst, invert, bgr);
+    case BLIT_FORMAT_GRAY8:
+    default:
+      return select_row_converter<BLIT_FORMAT_GRAY8, false>(dst, invert, bgr);
+  }
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
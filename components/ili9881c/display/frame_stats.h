@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace esphome {
+namespace ili9881c {
+
+// Nombre d'échantillons conservés par mesure (fenêtre glissante)
+static constexpr uint8_t FRAME_STATS_WINDOW = 64;
+
+// Statistiques glissantes d'une durée (µs) ou d'un volume (octets) par trame
+class FrameStat {
+ public:
+  void add(uint32_t value) {
+    this->samples_[this->next_] = value;
+    this->next_ = (this->next_ + 1) % FRAME_STATS_WINDOW;
+    if (this->count_ < FRAME_STATS_WINDOW) {
+      this->count_++;
+    }
+  }
+
+  uint8_t count() const { return this->count_; }
+
+  uint32_t min() const {
+    if (this->count_ == 0) {
+      return 0;
+    }
+    return *std::min_element(this->samples_, this->samples_ + this->count_);
+  }
+
+  uint32_t max() const {
+    if (this->count_ == 0) {
+      return 0;
+    }
+    return *std::max_element(this->samples_, this->samples_ + this->count_);
+  }
+
+  uint32_t avg() const {
+    if (this->count_ == 0) {
+      return 0;
+    }
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < this->count_; i++) {
+      sum += this->samples_[i];
+    }
+    return sum / this->count_;
+  }
+
+  // 95e centile sur une copie (au plus FRAME_STATS_WINDOW éléments)
+  uint32_t p95() const {
+    if (this->count_ == 0) {
+      return 0;
+    }
+    uint32_t sorted[FRAME_STATS_WINDOW];
+    std::copy(this->samples_, this->samples_ + this->count_, sorted);
+    const uint8_t rank = (this->count_ * 95 + 99) / 100 - 1;
+    std::nth_element(sorted, sorted + rank, sorted + this->count_);
+    return sorted[rank];
+  }
+
+ protected:
+  uint32_t samples_[FRAME_STATS_WINDOW]{};
+  uint8_t next_{0};
+  uint8_t count_{0};
+};
+
+}  // namespace ili9881c
+}  // namespace esphome
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace esphome {
+namespace ili9881c {
+
+// Surface maximale (pixels) d'un glyphe mis en cache ; au-delà, rendu direct par la police
+static constexpr uint16_t GLYPH_SLOT_MAX_PIXELS = 48 * 48;
+
+// Un glyphe rendu dépend de la police, du caractère (octets UTF-8) et des deux
+// couleurs : les polices anti-aliasées mélangent la couleur avec le fond
+struct GlyphKey {
+  const void *font;
+  uint32_t codepoint;
+  uint32_t color;
+  uint32_t background;
+
+  bool operator==(const GlyphKey &other) const {
+    return this->font == other.font && this->codepoint == other.codepoint && this->color == other.color &&
+           this->background == other.background;
+  }
+};
+
+// Boîte du glyphe relative au point de tracé (x : crayon, y : haut de la ligne de texte)
+struct GlyphSlot {
+  GlyphKey key{};
+  int16_t x{0};
+  int16_t y{0};
+  uint16_t width{0};
+  uint16_t height{0};
+  int16_t advance{0};
+  uint32_t last_used{0};
+  // Chaînage dans la table de hachage (-1 : fin)
+  int16_t next{-1};
+  bool used{false};
+  // Glyphe débordant de la boîte mesurée (mesure fondée sur l'avance) : toujours
+  // tracé directement par la police
+  bool direct{false};
+};
+
+// Cache LRU de glyphes au format natif du framebuffer : chaque emplacement réserve
+// GLYPH_SLOT_MAX_PIXELS pixels et autant d'octets de masque (pixel dessiné ou non)
+class GlyphCache {
+ public:
+  bool init(uint16_t slots, uint8_t bpp) {
+    RAMAllocator<uint8_t> allocator;
+    this->slot_bytes_ = (size_t) GLYPH_SLOT_MAX_PIXELS * (bpp + 1);
+    this->arena_ = allocator.allocate(slots * this->slot_bytes_);
+    if (this->arena_ == nullptr) {
+      return false;
+    }
+    this->bpp_ = bpp;
+    this->slots_.assign(slots, GlyphSlot{});
+    this->buckets_.assign(slots, -1);
+    return true;
+  }
+
+  bool enabled() const { return this->arena_ != nullptr; }
+
+  GlyphSlot *find(const GlyphKey &key) {
+    for (int16_t i = this->buckets_[this->bucket_(key)]; i >= 0; i = this->slots_[i].next) {
+      if (this->slots_[i].key == key) {
+        this->slots_[i].last_used = ++this->clock_;
+        this->hits_++;
+        return &this->slots_[i];
+      }
+    }
+    this->misses_++;
+    return nullptr;
+  }
+
+  // Emplacement libre, sinon le moins récemment utilisé, rattaché à key (contenu à remplir)
+  GlyphSlot *insert(const GlyphKey &key) {
+    int16_t victim = 0;
+    for (int16_t i = 0; i < (int16_t) this->slots_.size(); i++) {
+      if (!this->slots_[i].used) {
+        victim = i;
+        break;
+      }
+      if (this->slots_[i].last_used < this->slots_[victim].last_used) {
+        victim = i;
+      }
+    }
+    GlyphSlot &slot = this->slots_[victim];
+    if (slot.used) {
+      this->unlink_(victim);
+    }
+    const size_t bucket = this->bucket_(key);
+    slot = GlyphSlot{};
+    slot.key = key;
+    slot.used = true;
+    slot.last_used = ++this->clock_;
+    slot.next = this->buckets_[bucket];
+    this->buckets_[bucket] = victim;
+    return &slot;
+  }
+
+  uint8_t *pixels(const GlyphSlot *slot) { return this->arena_ + (slot - this->slots_.data()) * this->slot_bytes_; }
+  uint8_t *mask(const GlyphSlot *slot) { return this->pixels(slot) + (size_t) GLYPH_SLOT_MAX_PIXELS * this->bpp_; }
+
+  void clear() {
+    std::fill(this->slots_.begin(), this->slots_.end(), GlyphSlot{});
+    std::fill(this->buckets_.begin(), this->buckets_.end(), -1);
+  }
+
+  uint32_t hits() const { return this->hits_; }
+  uint32_t misses() const { return this->misses_; }
+
+ protected:
+  size_t bucket_(const GlyphKey &key) const {
+    uint32_t h = (uint32_t) reinterpret_cast<uintptr_t>(key.font) * 0x9E3779B1;
+    h ^= key.codepoint * 0x85EBCA77;
+    h ^= key.color * 0xC2B2AE3D;
+    h ^= key.background * 0x27D4EB2F;
+    return (h ^ (h >> 15)) % this->buckets_.size();
+  }
+
+  void unlink_(int16_t index) {
+    int16_t *link = &this->buckets_[this->bucket_(this->slots_[index].key)];
+    while (*link != index) {
+      link = &this->slots_[*link].next;
+    }
+    *link = this->slots_[index].next;
+  }
+
+  uint8_t *arena_{nullptr};
+  size_t slot_bytes_{0};
+  uint8_t bpp_{3};
+  std::vector<GlyphSlot> slots_;
+  std::vector<int16_t> buckets_;
+  uint32_t clock_{0};
+  uint32_t hits_{0};
+  uint32_t misses_{0};
+};
+
+}  // namespace ili9881c
+}  // namespace esphome
@@ -3,6 +3,13 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+
 #ifdef USE_ESP32
 
 namespace esphome {
@@ -10,8 +17,81 @@ namespace ili9881c {
 
 static const char *const TAG = "ili9881c";
 
+// Remplit count pixels consécutifs avec le même motif, par mots de 32 bits
+static void fill_span(uint8_t *dst, size_t count, const uint8_t *pixel, uint8_t bpp) {
+  // Motif uniforme (noir, blanc, gris en RGB888...) : memset
+  if (pixel[0] == pixel[1] && (bpp == 2 || pixel[1] == pixel[2])) {
+    memset(dst, pixel[0], count * bpp);
+    return;
+  }
+  
+  if (bpp == 2) {
+    const uint16_t value = pixel[0] | (pixel[1] << 8);
+    if (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 3) != 0) {
+      memcpy(dst, pixel, 2);
+      dst += 2;
+      count--;
+    }
+    // Deux pixels par mot
+    const uint32_t word = value | ((uint32_t) value << 16);
+    uint32_t *out = reinterpret_cast<uint32_t *>(dst);
+    for (; count >= 8; count -= 8) {
+      out[0] = word;
+      out[1] = word;
+      out[2] = word;
+      out[3] = word;
+      out += 4;
+    }
+    for (; count >= 2; count -= 2) {
+      *out++ = word;
+    }
+    if (count > 0) {
+      memcpy(out, pixel, 2);
+    }
+    return;
+  }
+  
+  // 3 octets par pixel : aligner sur 4 octets (au plus 3 pixels)
+  while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 3) != 0) {
+    memcpy(dst, pixel, 3);
+    dst += 3;
+    count--;
+  }
+  // Motif de 4 pixels sur 3 mots de 32 bits
+  uint8_t pattern[12];
+  for (int i = 0; i < 12; i += 3) {
+    memcpy(pattern + i, pixel, 3);
+  }
+  uint32_t w0, w1, w2;
+  memcpy(&w0, pattern, 4);
+  memcpy(&w1, pattern + 4, 4);
+  memcpy(&w2, pattern + 8, 4);
+  uint32_t *out = reinterpret_cast<uint32_t *>(dst);
+  for (; count >= 8; count -= 8) {
+    out[0] = w0;
+    out[1] = w1;
+    out[2] = w2;
+    out[3] = w0;
+    out[4] = w1;
+    out[5] = w2;
+    out += 6;
+  }
+  for (; count >= 4; count -= 4) {
+    out[0] = w0;
+    out[1] = w1;
+    out[2] = w2;
+    out += 3;
+  }
+  dst = reinterpret_cast<uint8_t *>(out);
+  for (; count > 0; count--) {
+    memcpy(dst, pixel, 3);
+    dst += 3;
+  }
+}
+
 void ILI9881C::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ILI9881C display...");
+  this->setup_start_ms_ = millis();
   
 #if !SOC_MIPI_DSI_SUPPORTED
   ESP_LOGE(TAG, "MIPI DSI not supported on this ESP32 variant");
@@ -25,9 +105,15 @@ void ILI9881C::setup() {
     this->reset_pin_->digital_write(true);
   }
   
-  // Séquence d'init par défaut si aucune fournie
-  if (this->init_commands_.empty()) {
-    this->setup_default_init_sequence_();
+  if (this->init_sequence_ == nullptr) {
+    ESP_LOGW(TAG, "No init sequence, relying on the panel's reset defaults");
+  }
+  
+  // Les setters restent accessibles après la validation de __init__.py
+  const LinkBudget budget = this->plan_link_();
+  if (budget.utilization > 1.0f) {
+    ESP_LOGW(TAG, "DSI link over budget: %.0f Mbps per lane needed, %u configured", budget.required_mbps,
+             this->lane_bit_rate_mbps_);
   }
   
   // Configurer MIPI DSI
@@ -36,47 +122,257 @@ void ILI9881C::setup() {
   // Configurer DPI
   this->setup_dpi_config_();
   
-  if (!this->init_display_()) {
-    Component::mark_failed();
+  // La suite (reset, séquence d'init, framebuffers) avance depuis loop()
+  // sans bloquer le démarrage des autres composants
+  this->init_state_ = INIT_STATE_RESET;
+  this->init_index_ = 0;
+  this->init_wait_until_ = millis();
+  ESP_LOGCONFIG(TAG, "ILI9881C panel bring-up started");
+}
+
+void ILI9881C::init_wait_(uint32_t delay_ms) {
+  this->init_wait_until_ = millis() + delay_ms;
+}
+
+void ILI9881C::advance_init_() {
+#if SOC_MIPI_DSI_SUPPORTED
+  while (true) {
+    // Attente en cours (reset ou délai de la séquence d'init)
+    if ((int32_t) (millis() - this->init_wait_until_) < 0) {
+      return;
+    }
+    
+    switch (this->init_state_) {
+      case INIT_STATE_RESET:
+        // Reset matériel : 10 ms à l'état bas puis 120 ms avant la première commande
+        this->init_state_ = INIT_STATE_COMMANDS;
+        if (this->reset_pin_ != nullptr) {
+          ESP_LOGD(TAG, "Performing hardware reset...");
+          this->reset_pin_->digital_write(false);
+          this->init_state_ = INIT_STATE_RESET_RELEASE;
+          this->init_wait_(10);
+        }
+        break;
+        
+      case INIT_STATE_RESET_RELEASE:
+        this->reset_pin_->digital_write(true);
+        this->init_state_ = INIT_STATE_COMMANDS;
+        this->init_wait_(120);
+        break;
+        
+      case INIT_STATE_COMMANDS:
+        // Commandes envoyées d'une traite jusqu'au prochain délai
+        while (this->init_index_ < this->init_sequence_length_) {
+          const uint8_t *record = this->init_sequence_ + this->init_index_;
+          const size_t remaining = this->init_sequence_length_ - this->init_index_;
+          if (record[0] == INIT_DELAY_RECORD) {
+            if (remaining < 3) {
+              ESP_LOGE(TAG, "Truncated delay in init sequence at offset %u", (unsigned) this->init_index_);
+              this->init_failed_();
+              return;
+            }
+            const uint16_t delay_ms = record[1] | (record[2] << 8);
+            ESP_LOGVV(TAG, "Delay: %dms", delay_ms);
+            this->init_index_ += 3;
+            this->init_wait_(delay_ms);
+            break;
+          }
+          const uint8_t len = record[0];
+          if (remaining < 2u + len) {
+            ESP_LOGE(TAG, "Truncated command in init sequence at offset %u", (unsigned) this->init_index_);
+            this->init_failed_();
+            return;
+          }
+          const uint8_t cmd = record[1];
+          ESP_LOGVV(TAG, "Command: 0x%02X with %d data bytes", cmd, len);
+          this->init_index_ += 2 + len;
+          esp_err_t ret = esp_lcd_panel_io_tx_param(this->io_handle_, cmd, len ? record + 2 : nullptr, len);
+          if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to send command 0x%02X: %s", cmd, esp_err_to_name(ret));
+            this->init_failed_();
+            return;
+          }
+        }
+        if (this->init_index_ >= this->init_sequence_length_) {
+          this->init_state_ = INIT_STATE_PANEL_ON;
+        }
+        break;
+        
+      case INIT_STATE_PANEL_ON:
+        // Le panel DPI diffuse toujours le framebuffer : rien d'autre à rétablir
+        if (this->recovering_) {
+          this->finish_recovery_();
+          return;
+        }
+        if (!this->init_display_() || !this->finish_setup_()) {
+          this->init_failed_();
+          return;
+        }
+        this->init_state_ = INIT_STATE_READY;
+        ESP_LOGCONFIG(TAG, "ILI9881C display ready after %u ms", (unsigned) (millis() - this->setup_start_ms_));
+        return;
+        
+      case INIT_STATE_IDLE:
+      case INIT_STATE_READY:
+      case INIT_STATE_FAILED:
+        return;
+    }
+  }
+#endif
+}
+
+void ILI9881C::init_failed_() {
+  // Échec pendant une réinitialisation : le contrôle suivant la relancera
+  if (this->recovering_) {
+    ESP_LOGW(TAG, "Panel recovery failed, retrying at the next health check");
+    this->recovering_ = false;
+    this->init_state_ = INIT_STATE_READY;
+    return;
+  }
+  this->init_state_ = INIT_STATE_FAILED;
+  Component::mark_failed();
+}
+
+void ILI9881C::recover() {
+  if (this->init_state_ != INIT_STATE_READY) {
+    return;
+  }
+  ESP_LOGW(TAG, "Re-initializing panel");
+  this->recovering_ = true;
+  this->recovery_start_ms_ = millis();
+  this->init_state_ = INIT_STATE_RESET;
+  this->init_index_ = 0;
+  this->init_wait_until_ = millis();
+}
+
+void ILI9881C::finish_recovery_() {
+  this->recovering_ = false;
+  this->init_state_ = INIT_STATE_READY;
+  this->health_failures_ = 0;
+  this->recovery_count_++;
+  this->last_recovery_ms_ = millis() - this->recovery_start_ms_;
+  ESP_LOGI(TAG, "Panel recovered in %u ms (%u recoveries)", (unsigned) this->last_recovery_ms_,
+           (unsigned) this->recovery_count_);
+#ifdef USE_SENSOR
+  if (this->recoveries_sensor_ != nullptr) {
+    this->recoveries_sensor_->publish_state(this->recovery_count_);
+  }
+  if (this->recovery_time_sensor_ != nullptr) {
+    this->recovery_time_sensor_->publish_state(this->last_recovery_ms_);
+  }
+#endif
+}
+
+bool ILI9881C::read_dcs_(uint8_t cmd, uint8_t *data, size_t len) {
+#if SOC_MIPI_DSI_SUPPORTED
+  // Le driver DBI envoie d'abord SET_MAXIMUM_RETURN_PACKET_SIZE (len) : le panel
+  // ne peut pas répondre plus que le buffer attendu
+  return esp_lcd_panel_io_rx_param(this->io_handle_, cmd, data, len) == ESP_OK;
+#else
+  return false;
+#endif
+}
+
+bool ILI9881C::read_panel_status_(PanelStatus &status) {
+  return this->read_dcs_(DCS_GET_POWER_MODE, &status.power_mode, 1) &&
+         this->read_dcs_(DCS_GET_DISPLAY_STATUS, status.display_status, sizeof(status.display_status)) &&
+         this->read_dcs_(DCS_GET_SIGNAL_MODE, &status.signal_mode, 1);
+}
+
+void ILI9881C::check_health_() {
+  if (this->init_state_ != INIT_STATE_READY) {
+    return;
+  }
+  PanelStatus status{};
+  const bool answered = this->read_panel_status_(status);
+  if (answered && (status.power_mode & POWER_MODE_READY) == POWER_MODE_READY &&
+      memcmp(status.display_status, this->panel_baseline_.display_status, sizeof(status.display_status)) == 0 &&
+      status.signal_mode == this->panel_baseline_.signal_mode) {
+    this->health_failures_ = 0;
     return;
   }
   
-  // Calculer la taille du buffer
-  size_t buffer_size = this->get_buffer_length_internal_();
-  this->init_internal_(buffer_size);
-  
-  ESP_LOGCONFIG(TAG, "ILI9881C display setup completed");
+  this->health_failures_++;
+  if (answered) {
+    ESP_LOGW(TAG, "Panel health check failed (%u/%u): power mode 0x%02X, signal mode 0x%02X",
+             this->health_failures_, HEALTH_CHECK_MAX_FAILURES, status.power_mode, status.signal_mode);
+  } else {
+    ESP_LOGW(TAG, "Panel health check failed (%u/%u): no answer to DCS reads", this->health_failures_,
+             HEALTH_CHECK_MAX_FAILURES);
+  }
+  if (this->health_failures_ >= HEALTH_CHECK_MAX_FAILURES) {
+    this->recover();
+  }
 }
 
-void ILI9881C::setup_default_init_sequence_() {
-  ESP_LOGD(TAG, "Setting up default initialization sequence");
+bool ILI9881C::finish_setup_() {
+  if (!this->setup_framebuffers_()) {
+    ESP_LOGE(TAG, "Failed to allocate frame buffer");
+    return false;
+  }
+  this->setup_layers_();
+  // Contenu initial des buffers inconnu (couleurs inversées, framebuffers DPI à zéro) :
+  // le premier effacement de chacun porte sur tout l'écran
+  for (uint8_t b = 0; b < this->num_framebuffers_; b++) {
+    this->drawn_rects_[b][0] = {0, 0, (uint16_t) this->get_buffer_width_(), (uint16_t) this->get_buffer_height_()};
+    this->drawn_count_[b] = 1;
+  }
+  if (this->glyph_cache_size_ > 0 && !this->glyph_cache_.init(this->glyph_cache_size_, this->get_bytes_per_pixel_())) {
+    ESP_LOGW(TAG, "No memory for the glyph cache, drawing text directly");
+  }
+  
+  // Avant le démarrage de la tâche de flush : le benchmark présente en synchrone
+  if (this->benchmark_) {
+    this->run_benchmark_();
+  }
   
-  this->clear_init_sequence();
+  // Un seul buffer : la trame suivante serait dessinée dans celle en cours de transfert
+  if (this->async_present_ && this->num_framebuffers_ < 2) {
+    ESP_LOGW(TAG, "Async present needs a second buffer, presenting synchronously");
+    this->async_present_ = false;
+  }
+  if (this->async_present_ && !this->setup_present_task_()) {
+    ESP_LOGW(TAG, "Failed to start flush task, presenting synchronously");
+  }
   
-  // Séquence d'initialisation ILI9881C standard
-  this->add_init_command(0x01, {}); // Software Reset
-  this->add_init_delay(100);
+#if SOC_PPA_SUPPORTED
+  // Remplissages étendus (effacement) sur le moteur 2D-DMA
+  ppa_client_config_t ppa_config = {};
+  ppa_config.oper_type = PPA_OPERATION_FILL;
+  ppa_config.max_pending_trans_num = 1;
+  if (this->external_flush_ || ppa_register_client(&ppa_config, &this->ppa_fill_) != ESP_OK) {
+    this->ppa_fill_ = nullptr;
+  }
+#endif
   
-  this->add_init_command(0x11, {}); // Sleep Out
-  this->add_init_delay(120);
+  if (!this->setup_vsync_()) {
+    ESP_LOGW(TAG, "Failed to register refresh events, vsync disabled");
+  }
   
-  this->add_init_command(0x3A, {0x77}); // Interface Pixel Format - 24bit RGB888
+  // L'auto-clear est appliqué par update() selon auto_clear_enabled_
+  display::Display::set_auto_clear(false);
   
-  // Configuration Memory Access Control selon rotation et couleurs
-  uint8_t madctl = 0x00;
-  switch (this->rotation_) {
-    case ROTATION_0:   madctl = 0x00; break;
-    case ROTATION_90:  madctl = 0x60; break; 
-    case ROTATION_180: madctl = 0xC0; break;
-    case ROTATION_270: madctl = 0xA0; break;
+  if (this->stats_interval_ms_ > 0) {
+    this->stats_last_ms_ = millis();
+    this->set_interval("frame_stats", this->stats_interval_ms_, [this]() { this->log_frame_stats_(); });
   }
-  if (this->color_order_ == COLOR_ORDER_BGR) {
-    madctl |= 0x08; // BGR bit
+  
+  // Référence relevée sur le panel fraîchement initialisé
+  if (this->health_check_interval_ms_ > 0) {
+    if (this->read_panel_status_(this->panel_baseline_)) {
+      this->set_interval("health_check", this->health_check_interval_ms_, [this]() { this->check_health_(); });
+    } else {
+      ESP_LOGW(TAG, "Panel does not answer DCS reads, health check disabled");
+      this->health_check_interval_ms_ = 0;
+    }
   }
-  this->add_init_command(0x36, {madctl}); // Memory Access Control
   
-  this->add_init_command(0x29, {}); // Display On
-  this->add_init_delay(20);
+  // Le premier flush envoie l'écran complet
+  if (!this->external_flush_) {
+    this->mark_dirty_(0, 0, this->get_buffer_width_(), this->get_buffer_height_());
+  }
+  this->initialized_ = true;
+  return true;
 }
 
 void ILI9881C::setup_mipi_dsi_() {
@@ -118,36 +414,55 @@ void ILI9881C::setup_dpi_config_() {
 #if SOC_MIPI_DSI_SUPPORTED
   ESP_LOGD(TAG, "Configuring DPI...");
   
-  // Allouer la config DPI
-  this->dpi_config_ = (esp_lcd_dpi_panel_config_t*)heap_caps_malloc(sizeof(esp_lcd_dpi_panel_config_t), MALLOC_CAP_DMA);
-  if (!this->dpi_config_) {
-    ESP_LOGE(TAG, "Failed to allocate DPI config");
-    return;
+  // Configuration DPI : copiée par esp_lcd_new_panel_dpi, elle reste sur la pile
+  esp_lcd_dpi_panel_config_t dpi_config = {};
+  dpi_config.dpi_clk_src = MIPI_DSI_DPI_CLK_SRC_DEFAULT;
+  dpi_config.dpi_clock_freq_mhz = this->dpi_clk_freq_mhz_;
+  dpi_config.virtual_channel = 0;
+  // Le RGB666 est stocké en RGB888 (2 bits bas à zéro) : le pont DPI lit du
+  // RGB888 et n'émet que des paquets 18 bits vers le panneau
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 5, 0)
+  switch (this->pixel_format_) {
+    case PIXEL_FORMAT_RGB565:
+      dpi_config.in_color_format = LCD_COLOR_FMT_RGB565;
+      dpi_config.out_color_format = LCD_COLOR_FMT_RGB565;
+      break;
+    case PIXEL_FORMAT_RGB666:
+      dpi_config.in_color_format = LCD_COLOR_FMT_RGB888;
+      dpi_config.out_color_format = LCD_COLOR_FMT_RGB666;
+      break;
+    case PIXEL_FORMAT_RGB888:
+      dpi_config.in_color_format = LCD_COLOR_FMT_RGB888;
+      dpi_config.out_color_format = LCD_COLOR_FMT_RGB888;
+      break;
   }
-  
-  // Configuration DPI
-  memset(this->dpi_config_, 0, sizeof(esp_lcd_dpi_panel_config_t));
-  this->dpi_config_->dpi_clk_src = MIPI_DSI_DPI_CLK_SRC_DEFAULT;
-  this->dpi_config_->dpi_clock_freq_mhz = this->dpi_clk_freq_mhz_;
-  this->dpi_config_->virtual_channel = 0;
-  this->dpi_config_->pixel_format = LCD_COLOR_PIXEL_FORMAT_RGB888;
-  this->dpi_config_->num_fbs = 1;
+#else
+  switch (this->pixel_format_) {
+    case PIXEL_FORMAT_RGB565: dpi_config.pixel_format = LCD_COLOR_PIXEL_FORMAT_RGB565; break;
+    case PIXEL_FORMAT_RGB666:
+      // Sans format de sortie distinct, le driver attendrait un framebuffer 18 bits compacté
+      ESP_LOGE(TAG, "RGB666 requires ESP-IDF 5.5 or later");
+      return;
+    case PIXEL_FORMAT_RGB888: dpi_config.pixel_format = LCD_COLOR_PIXEL_FORMAT_RGB888; break;
+  }
+#endif
+  dpi_config.num_fbs = this->direct_framebuffer_ ? this->num_framebuffers_ : 1;
   
   // Video timings
-  this->dpi_config_->video_timing.h_size = this->display_width_;
-  this->dpi_config_->video_timing.v_size = this->display_height_;
-  this->dpi_config_->video_timing.hsync_back_porch = this->hbp_;
-  this->dpi_config_->video_timing.hsync_pulse_width = this->hsync_;
-  this->dpi_config_->video_timing.hsync_front_porch = this->hfp_;
-  this->dpi_config_->video_timing.vsync_back_porch = this->vbp_;
-  this->dpi_config_->video_timing.vsync_pulse_width = this->vsync_;
-  this->dpi_config_->video_timing.vsync_front_porch = this->vfp_;
+  dpi_config.video_timing.h_size = this->display_width_;
+  dpi_config.video_timing.v_size = this->display_height_;
+  dpi_config.video_timing.hsync_back_porch = this->hbp_;
+  dpi_config.video_timing.hsync_pulse_width = this->hsync_;
+  dpi_config.video_timing.hsync_front_porch = this->hfp_;
+  dpi_config.video_timing.vsync_back_porch = this->vbp_;
+  dpi_config.video_timing.vsync_pulse_width = this->vsync_;
+  dpi_config.video_timing.vsync_front_porch = this->vfp_;
   
   // Flags
-  this->dpi_config_->flags.use_dma2d = true;
+  dpi_config.flags.use_dma2d = true;
   
   // Créer le panel DPI
-  esp_err_t ret = esp_lcd_new_panel_dpi(this->dsi_bus_, this->dpi_config_, &this->dpi_panel_);
+  esp_err_t ret = esp_lcd_new_panel_dpi(this->dsi_bus_, &dpi_config, &this->dpi_panel_);
   if (ret != ESP_OK) {
     ESP_LOGE(TAG, "Failed to create DPI panel: %s", esp_err_to_name(ret));
     return;
@@ -160,34 +475,7 @@ void ILI9881C::setup_dpi_config_() {
 
 bool ILI9881C::init_display_() {
 #if SOC_MIPI_DSI_SUPPORTED
-  ESP_LOGD(TAG, "Initializing display...");
-  
-  // Reset manuel
-  if (this->reset_pin_ != nullptr) {
-    ESP_LOGD(TAG, "Performing hardware reset...");
-    this->reset_pin_->digital_write(false);
-    delay(10);
-    this->reset_pin_->digital_write(true);
-    delay(120);
-  }
-  
-  // Envoyer la séquence d'initialisation via DBI
-  for (const auto &cmd : this->init_commands_) {
-    if (cmd.is_delay) {
-      ESP_LOGVV(TAG, "Delay: %dms", cmd.delay_ms);
-      delay(cmd.delay_ms);
-    } else {
-      ESP_LOGVV(TAG, "Command: 0x%02X with %d data bytes", cmd.cmd, cmd.data.size());
-      esp_err_t ret = esp_lcd_panel_io_tx_param(this->io_handle_, cmd.cmd, 
-        cmd.data.empty() ? nullptr : cmd.data.data(), cmd.data.size());
-      if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to send command 0x%02X: %s", cmd.cmd, esp_err_to_name(ret));
-        return false;
-      }
-    }
-  }
-  
-  // Initialiser le panel DPI
+  // Initialiser le panel DPI, une fois la séquence d'init envoyée
   esp_err_t ret = esp_lcd_panel_init(this->dpi_panel_);
   if (ret != ESP_OK) {
     ESP_LOGE(TAG, "Failed to init DPI panel: %s", esp_err_to_name(ret));
@@ -201,7 +489,6 @@ bool ILI9881C::init_display_() {
     return false;
   }
   
-  this->initialized_ = true;
   ESP_LOGD(TAG, "Display initialized successfully");
   return true;
 #else
@@ -211,165 +498,2070 @@ bool ILI9881C::init_display_() {
 }
 
 void ILI9881C::update() {
-  if (!this->initialized_) {
+  // En flush externe, la bibliothèque graphique écrit seule dans le framebuffer DPI
+  if (!this->initialized_ || this->external_flush_) {
+    return;
+  }
+  
+  // Contenu statique : ticks sautés, le rendu reprend à chaque changement
+  if (this->idle_skip_remaining_ > 0) {
+    this->idle_skip_remaining_--;
+    return;
+  }
+  
+  if (this->band_height_ > 0) {
+    this->update_bands_();
     return;
   }
   
+  // L'effacement est fait ici plutôt que par Display::do_update_() pour être mesuré à part
+  uint32_t start = micros();
+  if (this->auto_clear_enabled_) {
+    this->clear_drawn_regions_();
+    uint32_t now = micros();
+    this->clear_stat_.add(now - start);
+    start = now;
+  }
+  
+  // Zones à envoyer avant le rendu (effacement, trame reportée), remises
+  // de côté pour isoler ce que la trame dessine
+  DirtyRect pending[MAX_DIRTY_RECTS];
+  const uint8_t pending_count = this->dirty_count_;
+  memcpy(pending, this->dirty_rects_, pending_count * sizeof(DirtyRect));
+  this->dirty_count_ = 0;
+  this->last_dirty_ = 0;
+  
   this->do_update_();
+  // Le dessin reprend sur le rendu principal, puis les calques y sont composés
+  this->select_layer(LAYER_MAIN);
+  this->compose_layers_();
+  this->render_stat_.add(micros() - start);
+  
+  // Ce buffer contiendra ces zones jusqu'à sa prochaine utilisation
+  this->drawn_count_[this->back_buffer_] = this->dirty_count_;
+  memcpy(this->drawn_rects_[this->back_buffer_], this->dirty_rects_, this->dirty_count_ * sizeof(DirtyRect));
+  for (uint8_t i = 0; i < pending_count; i++) {
+    this->mark_dirty_(pending[i].x1, pending[i].y1, pending[i].x2, pending[i].y2);
+  }
+  
   this->send_display_buffer_();
 }
 
-void ILI9881C::send_display_buffer_() {
+void ILI9881C::update_bands_() {
+  // Chaque bande est effacée et redessinée à chaque trame : ni suivi des zones
+  // modifiées ni tâche de flush, le transfert de la bande N chevauche le rendu de N+1
+  if (this->vsync_sem_ != nullptr) {
+    this->wait_for_vsync_();
+  }
+  this->bytes_flushed_ = 0;
+  const BandPassTimes times = this->render_bands_(this->band_height_, [this]() { this->do_update_(); });
+  this->clear_stat_.add(times.clear_us);
+  this->render_stat_.add(times.render_us);
+  this->last_flush_us_ = times.flush_us;
+  this->flush_pending_ = true;
+  this->record_flush_();
+  
+  if (!this->first_frame_presented_) {
+    this->first_frame_presented_ = true;
+    ESP_LOGI(TAG, "First frame presented %u ms after boot", (unsigned) millis());
+  }
+}
+
+BandPassTimes ILI9881C::render_bands_(uint16_t band_height, const std::function<void()> &draw) {
+  BandPassTimes times{};
 #if SOC_MIPI_DSI_SUPPORTED
-  if (!this->dpi_panel_ || !this->initialized_) {
+  const int bw = this->get_buffer_width_();
+  const int bh = this->get_buffer_height_();
+  const size_t row_bytes = (size_t) bw * this->get_bytes_per_pixel_();
+  for (int top = 0; top < bh; top += band_height) {
+    const int rows = std::min<int>(band_height, bh - top);
+    // Les deux buffers alternent : draw_bitmap n'accepte une bande qu'une fois la
+    // copie 2D-DMA de la précédente terminée, le buffer réutilisé est donc libre
+    this->band_index_ ^= 1;
+    this->buffer_ = this->band_buffers_[this->band_index_];
+    this->set_band_(top, rows);
+    
+    uint32_t start = micros();
+    this->fill_rect_(0, top, bw, top + rows, COLOR_OFF);
+    uint32_t now = micros();
+    times.clear_us += now - start;
+    start = now;
+    draw();
+    this->dirty_count_ = 0;
+    this->last_dirty_ = 0;
+    now = micros();
+    times.render_us += now - start;
+    start = now;
+    
+    esp_err_t ret = esp_lcd_panel_draw_bitmap(this->dpi_panel_, 0, top, bw, top + rows, this->buffer_);
+    times.flush_us += micros() - start;
+    if (ret != ESP_OK) {
+      ESP_LOGE(TAG, "Failed to draw band at line %d: %s", top, esp_err_to_name(ret));
+      break;
+    }
+    this->bytes_flushed_ += rows * row_bytes;
+  }
+#endif
+  return times;
+}
+
+void ILI9881C::set_band_(int top, int rows) {
+  this->band_top_ = top;
+  this->band_rows_ = rows;
+  // Rotation inverse : lignes du panel -> rectangle logique
+  int x1 = 0, y1 = top, x2 = this->display_width_, y2 = top + rows;
+  const Rotation inverse = (Rotation) ((4 - this->rotation_) % 4);
+  rotate_rect(inverse, this->get_width_internal(), this->get_height_internal(), x1, y1, x2, y2);
+  this->band_clip_ = {(uint16_t) x1, (uint16_t) y1, (uint16_t) x2, (uint16_t) y2};
+}
+
+void ILI9881C::clear_drawn_regions_() {
+  // Le reste du buffer est déjà à la couleur de fond : seules les zones
+  // dessinées lors de la dernière utilisation de ce buffer sont effacées
+  const uint8_t index = this->back_buffer_;
+  for (uint8_t i = 0; i < this->drawn_count_[index]; i++) {
+    const DirtyRect &r = this->drawn_rects_[index][i];
+    if (this->background_ != nullptr) {
+      this->restore_background_(r);
+    } else {
+      this->fill_rect_(r.x1, r.y1, r.x2, r.y2, COLOR_OFF);
+    }
+  }
+  this->drawn_count_[index] = 0;
+  
+  // Ce que les autres buffers ont dessiné est encore à l'écran : ces zones
+  // sont renvoyées aussi quand le flush copie vers le framebuffer du driver
+  for (uint8_t b = 0; b < this->num_framebuffers_; b++) {
+    if (b == index) {
+      continue;
+    }
+    for (uint8_t i = 0; i < this->drawn_count_[b]; i++) {
+      const DirtyRect &r = this->drawn_rects_[b][i];
+      this->mark_dirty_(r.x1, r.y1, r.x2, r.y2);
+    }
+  }
+}
+
+void ILI9881C::add_drawn_rect_(uint8_t index, const DirtyRect &rect) {
+  if (this->drawn_count_[index] < MAX_DIRTY_RECTS) {
+    this->drawn_rects_[index][this->drawn_count_[index]++] = rect;
+    return;
+  }
+  // Liste pleine : le buffer sera entièrement effacé
+  this->drawn_rects_[index][0] = {0, 0, (uint16_t) this->get_buffer_width_(), (uint16_t) this->get_buffer_height_()};
+  this->drawn_count_[index] = 1;
+}
+
+void ILI9881C::add_overlay_layer(uint8_t alpha, bool use_color_key, uint32_t color_key) {
+  if (this->num_overlays_ >= MAX_OVERLAY_LAYERS) {
+    ESP_LOGW(TAG, "At most %u overlay layers are supported", MAX_OVERLAY_LAYERS);
     return;
   }
+  OverlayLayer &layer = this->overlays_[this->num_overlays_++];
+  layer.alpha = alpha;
+  layer.use_color_key = use_color_key;
+  layer.color_key = color_key;
+}
+
+void ILI9881C::setup_layers_() {
+  // Taille arrondie à la ligne de cache : le PPA synchronise le cache par lignes entières
+  const size_t size = (this->get_buffer_length_internal_() + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+  const uint8_t bpp = this->get_bytes_per_pixel_();
   
-  ESP_LOGVV(TAG, "Sending display buffer...");
+  if (this->background_layer_) {
+    // Les buffers de rendu partent à la couleur de fond : le calque de fond aussi
+    this->background_ = static_cast<uint8_t *>(
+      heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (this->background_ == nullptr) {
+      ESP_LOGW(TAG, "No memory for the background layer, clearing to black");
+    } else {
+      this->fill_off_(this->background_, this->get_buffer_length_internal_());
+    }
+  }
   
-  // Utiliser le panel DPI pour envoyer le buffer
-  esp_err_t ret = esp_lcd_panel_draw_bitmap(this->dpi_panel_, 
-    0, 0, this->display_width_, this->display_height_, this->buffer_);
+  for (uint8_t i = 0; i < this->num_overlays_; i++) {
+    OverlayLayer &layer = this->overlays_[i];
+    layer.buffer = static_cast<uint8_t *>(
+      heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (layer.buffer == nullptr) {
+      ESP_LOGW(TAG, "No memory for overlay layer %u, %u layer(s) available", i, i);
+      this->num_overlays_ = i;
+      break;
+    }
+    if (layer.use_color_key) {
+      // Calque vide : entièrement à la couleur clé
+      Color key((layer.color_key >> 16) & 0xFF, (layer.color_key >> 8) & 0xFF, layer.color_key & 0xFF);
+      this->pixel_encoder_(layer.key, 0, 0, key);
+      fill_span(layer.buffer, (size_t) this->get_buffer_width_() * this->get_buffer_height_(), layer.key, bpp);
+    }
+  }
   
-  if (ret != ESP_OK) {
-    ESP_LOGE(TAG, "Failed to draw bitmap: %s", esp_err_to_name(ret));
+#if SOC_PPA_SUPPORTED
+  if (this->num_overlays_ > 0) {
+    ppa_client_config_t ppa_config = {};
+    ppa_config.oper_type = PPA_OPERATION_BLEND;
+    ppa_config.max_pending_trans_num = 1;
+    if (ppa_register_client(&ppa_config, &this->ppa_blend_) != ESP_OK) {
+      this->ppa_blend_ = nullptr;
+    }
   }
 #endif
 }
 
-void ILI9881C::draw_absolute_pixel_internal(int x, int y, Color color) {
-  if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0) {
-    return;
+bool ILI9881C::select_layer(int8_t layer) {
+  if (layer == this->active_layer_) {
+    return true;
+  }
+  uint8_t *target = nullptr;
+  if (layer == LAYER_MAIN) {
+    target = this->main_buffer_;
+  } else if (layer == LAYER_BACKGROUND) {
+    target = this->background_;
+  } else if (layer >= 0 && layer < this->num_overlays_) {
+    target = this->overlays_[layer].buffer;
+  }
+  if (target == nullptr) {
+    ESP_LOGW(TAG, "Layer %d is not available", layer);
+    return false;
   }
   
-  // Appliquer l'offset
-  int pixel_x = x + this->offset_x_;
-  int pixel_y = y + this->offset_y_;
-  
-  // Vérifier les limites avec offset
-  if (pixel_x >= this->display_width_ || pixel_x < 0 || pixel_y >= this->display_height_ || pixel_y < 0) {
+  if (this->active_layer_ == LAYER_MAIN) {
+    this->main_buffer_ = this->buffer_;
+  } else if (this->active_layer_ == LAYER_BACKGROUND && this->background_drawn_) {
+    // Fond modifié : recopié tout de suite dans la trame en cours (le fond se dessine
+    // donc avant le reste), et à leur prochaine utilisation dans les autres buffers
+    this->background_drawn_ = false;
+    this->buffer_ = this->main_buffer_;
+    this->active_layer_ = LAYER_MAIN;
+    this->restore_background_(this->background_bounds_);
+    for (uint8_t b = 0; b < this->num_framebuffers_; b++) {
+      if (b != this->back_buffer_) {
+        this->add_drawn_rect_(b, this->background_bounds_);
+      }
+    }
+  }
+  this->buffer_ = target;
+  this->active_layer_ = layer;
+  return true;
+}
+
+void ILI9881C::clear_layer(uint8_t index) {
+  if (index >= this->num_overlays_ || !this->overlays_[index].has_content) {
     return;
   }
-  
-  // Extraire les composantes de couleur
-  uint8_t r = color.red;
-  uint8_t g = color.green;
-  uint8_t b = color.blue;
-  
-  // Appliquer l'inversion des couleurs
-  if (this->invert_colors_) {
-    r = 255 - r;
-    g = 255 - g;
-    b = 255 - b;
+  OverlayLayer &layer = this->overlays_[index];
+  const DirtyRect &r = layer.bounds;
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const size_t row_bytes = (size_t) this->get_buffer_width_() * bpp;
+  static const uint8_t TRANSPARENT[3] = {0, 0, 0};
+  const uint8_t *pixel = layer.use_color_key ? layer.key : TRANSPARENT;
+  for (int y = r.y1; y < r.y2; y++) {
+    fill_span(layer.buffer + y * row_bytes + r.x1 * bpp, r.x2 - r.x1, pixel, bpp);
   }
-  
-  // RGB888 - 24-bit per pixel  
-  size_t pos = (pixel_y * this->display_width_ + pixel_x) * 3;
-  if (pos + 2 < this->get_buffer_length_internal_()) {
-    // L'ordre des couleurs est géré par MADCTL dans init
-    this->buffer_[pos] = r;
-    this->buffer_[pos + 1] = g;
-    this->buffer_[pos + 2] = b;
+  this->mark_dirty_(r.x1, r.y1, r.x2, r.y2);
+  layer.has_content = false;
+}
+
+void ILI9881C::set_layer_alpha(uint8_t index, uint8_t alpha) {
+  if (index >= this->num_overlays_ || this->overlays_[index].alpha == alpha) {
+    return;
+  }
+  OverlayLayer &layer = this->overlays_[index];
+  layer.alpha = alpha;
+  if (layer.has_content) {
+    this->mark_dirty_(layer.bounds.x1, layer.bounds.y1, layer.bounds.x2, layer.bounds.y2);
   }
 }
 
-void ILI9881C::loop() {
-  // Rien à faire dans la boucle
+void ILI9881C::set_layer_visible(uint8_t index, bool visible) {
+  if (index >= this->num_overlays_ || this->overlays_[index].visible == visible) {
+    return;
+  }
+  OverlayLayer &layer = this->overlays_[index];
+  layer.visible = visible;
+  if (layer.has_content) {
+    this->mark_dirty_(layer.bounds.x1, layer.bounds.y1, layer.bounds.x2, layer.bounds.y2);
+  }
 }
 
-void ILI9881C::dump_config() {
-  ESP_LOGCONFIG(TAG, "ILI9881C Display:");
-  ESP_LOGCONFIG(TAG, "  Physical Size: %dx%d", this->display_width_, this->display_height_);
-  ESP_LOGCONFIG(TAG, "  Effective Size: %dx%d", this->get_width_internal(), this->get_height_internal());
+void ILI9881C::restore_background_(const DirtyRect &rect) {
+  const size_t row_bytes = (size_t) this->get_buffer_width_() * this->get_bytes_per_pixel_();
+  const size_t offset = rect.y1 * row_bytes + rect.x1 * this->get_bytes_per_pixel_();
+  const size_t span = (size_t) (rect.x2 - rect.x1) * this->get_bytes_per_pixel_();
+  if (span == row_bytes) {
+    // Lignes complètes : une seule copie
+    memcpy(this->buffer_ + offset, this->background_ + offset, span * (rect.y2 - rect.y1));
+  } else {
+    for (int y = rect.y1; y < rect.y2; y++) {
+      const size_t row = offset + (y - rect.y1) * row_bytes;
+      memcpy(this->buffer_ + row, this->background_ + row, span);
+    }
+  }
+  this->mark_dirty_(rect.x1, rect.y1, rect.x2, rect.y2);
+}
+
+void ILI9881C::compose_layers_() {
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const size_t row_bytes = (size_t) this->get_buffer_width_() * bpp;
+  for (uint8_t i = 0; i < this->num_overlays_; i++) {
+    const OverlayLayer &layer = this->overlays_[i];
+    if (!layer.visible || !layer.has_content || layer.alpha == 0) {
+      continue;
+    }
+    // Le calque est recomposé sur toute sa zone : elle a été restaurée par l'effacement
+    const DirtyRect &r = layer.bounds;
+    if (!this->compose_layer_ppa_(layer, r)) {
+      const uint8_t *key = layer.use_color_key ? layer.key : nullptr;
+      for (int y = r.y1; y < r.y2; y++) {
+        const size_t offset = y * row_bytes + r.x1 * bpp;
+        compose_row(layer.buffer + offset, this->buffer_ + offset, r.x2 - r.x1, bpp, layer.alpha, key);
+      }
+    }
+    this->mark_dirty_(r.x1, r.y1, r.x2, r.y2);
+  }
+}
+
+bool ILI9881C::compose_layer_ppa_(const OverlayLayer &layer, const DirtyRect &rect) {
+#if SOC_PPA_SUPPORTED
+  const uint32_t w = rect.x2 - rect.x1;
+  const uint32_t h = rect.y2 - rect.y1;
+  if (this->ppa_blend_ == nullptr || w * h < PPA_BLEND_MIN_PIXELS) {
+    return false;
+  }
+  // RGB666 est stocké en RGB888 : mélangé tel quel, les 2 bits bas sont ignorés au transfert DSI
+  const bool rgb565 = this->pixel_format_ == PIXEL_FORMAT_RGB565;
+  const ppa_blend_color_mode_t color_mode = rgb565 ? PPA_BLEND_COLOR_MODE_RGB565 : PPA_BLEND_COLOR_MODE_RGB888;
   
-  int rotation_degrees = 0;
-  switch (this->rotation_) {
-    case ROTATION_0: rotation_degrees = 0; break;
-    case ROTATION_90: rotation_degrees = 90; break;
-    case ROTATION_180: rotation_degrees = 180; break;
-    case ROTATION_270: rotation_degrees = 270; break;
+  ppa_blend_oper_config_t blend = {};
+  blend.in_bg.buffer = this->buffer_;
+  blend.in_bg.pic_w = this->get_buffer_width_();
+  blend.in_bg.pic_h = this->get_buffer_height_();
+  blend.in_bg.block_w = w;
+  blend.in_bg.block_h = h;
+  blend.in_bg.block_offset_x = rect.x1;
+  blend.in_bg.block_offset_y = rect.y1;
+  blend.in_bg.blend_cm = color_mode;
+  blend.in_fg = blend.in_bg;
+  blend.in_fg.buffer = layer.buffer;
+  blend.out.buffer = this->buffer_;
+  blend.out.buffer_size = this->get_buffer_length_internal_();
+  blend.out.pic_w = this->get_buffer_width_();
+  blend.out.pic_h = this->get_buffer_height_();
+  blend.out.block_offset_x = rect.x1;
+  blend.out.block_offset_y = rect.y1;
+  blend.out.blend_cm = color_mode;
+  blend.bg_alpha_update_mode = PPA_ALPHA_NO_CHANGE;
+  blend.fg_alpha_update_mode = PPA_ALPHA_FIX_VALUE;
+  blend.fg_alpha_fix_val = layer.alpha;
+  if (layer.use_color_key) {
+    // Plage de la couleur clé dans l'ordre mémoire du PPA (B, G, R), bits de
+    // quantification compris
+    blend.fg_ck_en = true;
+    if (rgb565) {
+      const uint16_t v = layer.key[0] | (layer.key[1] << 8);
+      blend.fg_ck_rgb_low_thres.r = (v >> 8) & 0xF8;
+      blend.fg_ck_rgb_low_thres.g = (v >> 3) & 0xFC;
+      blend.fg_ck_rgb_low_thres.b = (v << 3) & 0xF8;
+      blend.fg_ck_rgb_high_thres.r = blend.fg_ck_rgb_low_thres.r | 0x07;
+      blend.fg_ck_rgb_high_thres.g = blend.fg_ck_rgb_low_thres.g | 0x03;
+      blend.fg_ck_rgb_high_thres.b = blend.fg_ck_rgb_low_thres.b | 0x07;
+    } else {
+      blend.fg_ck_rgb_low_thres.b = layer.key[0];
+      blend.fg_ck_rgb_low_thres.g = layer.key[1];
+      blend.fg_ck_rgb_low_thres.r = layer.key[2];
+      blend.fg_ck_rgb_high_thres = blend.fg_ck_rgb_low_thres;
+    }
+  }
+  blend.mode = PPA_TRANS_MODE_BLOCKING;
+  esp_err_t ret = ppa_do_blend(this->ppa_blend_, &blend);
+  if (ret != ESP_OK) {
+    ESP_LOGD(TAG, "PPA blend unavailable for this buffer, composing on the CPU: %s", esp_err_to_name(ret));
+    this->ppa_blend_ = nullptr;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ILI9881C::send_display_buffer_() {
+#if SOC_MIPI_DSI_SUPPORTED
+  if (!this->dpi_panel_ || !this->initialized_) {
+    return;
   }
-  ESP_LOGCONFIG(TAG, "  Rotation: %d°", rotation_degrees);
   
-  ESP_LOGCONFIG(TAG, "  Color Order: %s", this->color_order_ == COLOR_ORDER_RGB ? "RGB" : "BGR");
-  ESP_LOGCONFIG(TAG, "  Offset: (%d, %d)", this->offset_x_, this->offset_y_);
-  ESP_LOGCONFIG(TAG, "  Invert Colors: %s", YESNO(this->invert_colors_));
-  ESP_LOGCONFIG(TAG, "  Auto Clear: %s", YESNO(this->auto_clear_enabled_));
+  if (!this->partial_updates_) {
+    this->mark_dirty_(0, 0, this->get_buffer_width_(), this->get_buffer_height_());
+  }
   
-  ESP_LOGCONFIG(TAG, "  MIPI DSI Configuration:");
-  ESP_LOGCONFIG(TAG, "    Data Lanes: %d", this->data_lanes_);
-  ESP_LOGCONFIG(TAG, "    Lane Bit Rate: %d Mbps", this->lane_bit_rate_mbps_);
-  ESP_LOGCONFIG(TAG, "    DPI Clock: %d MHz", this->dpi_clk_freq_mhz_);
+  if (this->dirty_count_ == 0) {
+    this->present_pending_ = false;
+    ESP_LOGVV(TAG, "Nothing to send, buffer unchanged");
+    return;
+  }
   
-  ESP_LOGCONFIG(TAG, "  DPI Video Timings:");
-  ESP_LOGCONFIG(TAG, "    H: %d + %d + %d + %d = %d", 
-    this->hbp_, this->display_width_, this->hfp_, this->hsync_, 
-    this->hbp_ + this->display_width_ + this->hfp_ + this->hsync_);
-  ESP_LOGCONFIG(TAG, "    V: %d + %d + %d + %d = %d", 
-    this->vbp_, this->display_height_, this->vfp_, this->vsync_,
-    this->vbp_ + this->display_height_ + this->vfp_ + this->vsync_);
+  // Contre-pression sans bloquer la boucle principale : tant que la trame précédente
+  // est en transfert, le present est reporté et retenté depuis loop()
+  if (this->present_task_handle_ != nullptr) {
+    if (xSemaphoreTake(this->present_done_, 0) != pdTRUE) {
+      // Les zones modifiées sont conservées pour le present reporté
+      if (!this->present_pending_) {
+        this->present_pending_ = true;
+        this->present_deferred_us_ = micros();
+        this->frames_deferred_++;
+      }
+      ESP_LOGVV(TAG, "Previous frame still in flight, present deferred");
+      return;
+    }
+    if (this->present_pending_) {
+      this->present_pending_ = false;
+      this->present_wait_us_ = micros() - this->present_deferred_us_;
+    }
+    this->record_flush_();
+  }
   
-  ESP_LOGCONFIG(TAG, "  Buffer Size: %.2f MB", this->get_buffer_length_internal_() / (1024.0 * 1024.0));
-  ESP_LOGCONFIG(TAG, "  Init Commands: %zu", this->init_commands_.size());
+  // Contenu identique à la trame présentée : rien à envoyer
+  if (this->skip_unchanged_ && !this->filter_unchanged_bands_()) {
+    this->dirty_count_ = 0;
+    this->last_dirty_ = 0;
+    this->frames_unchanged_++;
+    this->back_off_update_();
+    if (this->present_task_handle_ != nullptr) {
+      xSemaphoreGive(this->present_done_);
+    }
+    ESP_LOGVV(TAG, "Frame unchanged, present skipped");
+    return;
+  }
+  this->idle_skip_ = 0;
+  this->idle_skip_remaining_ = 0;
   
-  LOG_PIN("  Reset Pin: ", this->reset_pin_);
+  FrameJob job;
+  job.buffer = this->buffer_;
+  job.scroll_offset = this->scroll_offset_;
+  job.count = this->dirty_count_;
+  memcpy(job.rects, this->dirty_rects_, job.count * sizeof(DirtyRect));
+  this->dirty_count_ = 0;
+  this->last_dirty_ = 0;
   
-#if !SOC_MIPI_DSI_SUPPORTED
-  ESP_LOGE(TAG, "MIPI DSI not supported on this ESP32 variant");
-#endif
+  if (this->present_task_handle_ != nullptr) {
+    // Toujours de la place : la file a une entrée et present_done_ vient d'être pris
+    xQueueSend(this->present_queue_, &job, 0);
+  } else {
+    this->present_frame_(job);
+    this->record_flush_();
+    ESP_LOGVV(TAG, "Display buffer sent: %u bytes", (unsigned) this->bytes_flushed_);
+  }
   
-  if (Component::is_failed()) {
-    ESP_LOGE(TAG, "Failed to initialize display");
+  if (!this->first_frame_presented_) {
+    this->first_frame_presented_ = true;
+    ESP_LOGI(TAG, "First frame presented %u ms after boot", (unsigned) millis());
   }
+  
+  // La trame suivante est rendue dans un autre buffer pendant le transfert
+  if (this->num_framebuffers_ > 1) {
+    DirtyRect bands[MAX_DIRTY_RECTS];
+    uint8_t count = this->build_flush_bands_(job.rects, job.count, bands);
+    this->swap_framebuffers_(bands, count);
+  }
+#endif
 }
 
-// Méthodes de configuration
-void ILI9881C::set_dimensions(uint16_t width, uint16_t height) {
-  this->display_width_ = width;
-  this->display_height_ = height;
-}
-
-void ILI9881C::set_offsets(uint16_t offset_x, uint16_t offset_y) {
-  this->offset_x_ = offset_x;
-  this->offset_y_ = offset_y;
-}
-
-void ILI9881C::set_rotation(Rotation rotation) {
-  this->rotation_ = rotation;
+// Empreinte de lignes du framebuffer, deux mots de 32 bits par itération
+static uint32_t hash_rows(const uint8_t *data, size_t len) {
+  uint32_t h0 = 0x811C9DC5;
+  uint32_t h1 = 0x01000193;
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint32_t w0, w1;
+    memcpy(&w0, data + i, 4);
+    memcpy(&w1, data + i + 4, 4);
+    h0 = (h0 ^ w0) * 0x9E3779B1;
+    h1 = (h1 ^ w1) * 0x85EBCA77;
+  }
+  for (; i < len; i++) {
+    h0 = (h0 ^ data[i]) * 0x01000193;
+  }
+  h0 ^= (h1 << 13) | (h1 >> 19);
+  return h0 ^ (h0 >> 16);
 }
 
-void ILI9881C::add_init_command(uint8_t cmd, const std::vector<uint8_t> &data) {
-  InitCommand init_cmd;
-  init_cmd.cmd = cmd;
-  init_cmd.data = data;
-  init_cmd.delay_ms = 0;
-  init_cmd.is_delay = false;
-  this->init_commands_.push_back(init_cmd);
-}
+bool ILI9881C::filter_unchanged_bands_() {
+  const int bh = this->get_buffer_height_();
+  const size_t band_count = (bh + HASH_BAND_ROWS - 1) / HASH_BAND_ROWS;
+  if (this->band_hashes_.size() != band_count) {
+    // Première trame : toutes les bandes sont considérées modifiées
+    this->band_hashes_.assign(band_count, 0);
+    this->band_changed_.assign(band_count, 0);
+    this->hashes_valid_ = false;
+  }
+  
+  // Recalculer l'empreinte des seules bandes touchées depuis le dernier present
+  const size_t row_bytes = (size_t) this->get_buffer_width_() * this->get_bytes_per_pixel_();
+  std::fill(this->band_changed_.begin(), this->band_changed_.end(), 0);
+  bool changed = false;
+  for (uint8_t i = 0; i < this->dirty_count_; i++) {
+    const DirtyRect &r = this->dirty_rects_[i];
+    for (size_t b = r.y1 / HASH_BAND_ROWS; b <= (size_t) (r.y2 - 1) / HASH_BAND_ROWS; b++) {
+      if (this->band_changed_[b] != 0) {
+        continue;
+      }
+      const int y1 = b * HASH_BAND_ROWS;
+      const int y2 = std::min<int>(y1 + HASH_BAND_ROWS, bh);
+      // Bande coupée par le bouclage de la zone de défilement : empreintes chaînées
+      uint32_t hash = 0;
+      for (int y = y1; y < y2;) {
+        const int end = this->row_run_end_(y, y2, this->scroll_offset_);
+        hash = hash * 31 + hash_rows(this->buffer_ + this->map_row_(y) * row_bytes, (end - y) * row_bytes);
+        y = end;
+      }
+      // 1 : vérifiée, identique ; 2 : modifiée
+      this->band_changed_[b] = (hash != this->band_hashes_[b] || !this->hashes_valid_) ? 2 : 1;
+      if (this->band_changed_[b] == 2) {
+        this->band_hashes_[b] = hash;
+        changed = true;
+      }
+    }
+  }
+  this->hashes_valid_ = true;
+  if (!changed) {
+    return false;
+  }
+  
+  // Restreindre les zones modifiées aux bandes dont le contenu a changé
+  DirtyRect rects[MAX_DIRTY_RECTS];
+  const uint8_t count = this->dirty_count_;
+  memcpy(rects, this->dirty_rects_, count * sizeof(DirtyRect));
+  this->dirty_count_ = 0;
+  this->last_dirty_ = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const DirtyRect &r = rects[i];
+    int run_start = -1;
+    for (int y = r.y1; y < r.y2; y = (y / HASH_BAND_ROWS + 1) * HASH_BAND_ROWS) {
+      const bool band_changed = this->band_changed_[y / HASH_BAND_ROWS] == 2;
+      if (band_changed && run_start < 0) {
+        run_start = y;
+      } else if (!band_changed && run_start >= 0) {
+        this->mark_dirty_(r.x1, run_start, r.x2, y);
+        run_start = -1;
+      }
+    }
+    if (run_start >= 0) {
+      this->mark_dirty_(r.x1, run_start, r.x2, r.y2);
+    }
+  }
+  return true;
+}
+
+void ILI9881C::back_off_update_() {
+  if (this->max_idle_interval_ms_ == 0) {
+    return;
+  }
+  // Doubler l'intervalle effectif tant que le contenu reste statique
+  const uint32_t interval = this->vsync_divisor_ > 0
+                                ? this->vsync_divisor_ * 1000 / std::max(this->get_refresh_rate_(), 1.0f)
+                                : this->get_update_interval();
+  const uint32_t next = this->idle_skip_ == 0 ? 1 : this->idle_skip_ * 2;
+  if ((uint64_t) (next + 1) * interval <= this->max_idle_interval_ms_) {
+    this->idle_skip_ = next;
+  }
+  this->idle_skip_remaining_ = this->idle_skip_;
+}
+
+void ILI9881C::request_redraw() {
+  this->idle_skip_ = 0;
+  this->idle_skip_remaining_ = 0;
+}
+
+void ILI9881C::present_frame_(const FrameJob &job) {
+  if (this->vsync_sem_ != nullptr) {
+    this->wait_for_vsync_();
+  }
+  const uint32_t start = micros();
+  this->bytes_flushed_ = 0;
+  if (this->rotate_on_flush_()) {
+    this->flush_rotated_(job);
+  } else {
+    this->flush_dirty_rects_(job);
+  }
+  this->last_flush_us_ = micros() - start;
+  this->flush_pending_ = true;
+}
+
+void ILI9881C::record_flush_() {
+  // Appelé par la boucle principale quand aucune trame n'est en cours de transfert
+  if (!this->flush_pending_) {
+    return;
+  }
+  this->flush_pending_ = false;
+  this->flush_stat_.add(this->last_flush_us_);
+  // Attente de la trame précédente et de la vsync
+  this->wait_stat_.add(this->present_wait_us_ + this->last_vsync_wait_us_);
+  this->present_wait_us_ = 0;
+  this->bytes_stat_.add(this->bytes_flushed_);
+  this->frames_presented_++;
+}
+
+void ILI9881C::log_frame_stats_() {
+  const uint32_t now = millis();
+  const float fps = now != this->stats_last_ms_ ? this->frames_presented_ * 1000.0f / (now - this->stats_last_ms_) : 0.0f;
+  this->frames_presented_ = 0;
+  this->stats_last_ms_ = now;
+  
+  // Durées en µs : min/moy/p95/max sur la fenêtre glissante
+  ESP_LOGD(TAG, "%.1f fps, %u bytes/frame | render %u/%u/%u/%u | clear %u/%u/%u/%u | flush %u/%u/%u/%u | "
+           "wait %u/%u/%u/%u us", fps, (unsigned) this->bytes_stat_.avg(),
+           (unsigned) this->render_stat_.min(), (unsigned) this->render_stat_.avg(),
+           (unsigned) this->render_stat_.p95(), (unsigned) this->render_stat_.max(),
+           (unsigned) this->clear_stat_.min(), (unsigned) this->clear_stat_.avg(),
+           (unsigned) this->clear_stat_.p95(), (unsigned) this->clear_stat_.max(),
+           (unsigned) this->flush_stat_.min(), (unsigned) this->flush_stat_.avg(),
+           (unsigned) this->flush_stat_.p95(), (unsigned) this->flush_stat_.max(),
+           (unsigned) this->wait_stat_.min(), (unsigned) this->wait_stat_.avg(),
+           (unsigned) this->wait_stat_.p95(), (unsigned) this->wait_stat_.max());
+  if (this->glyph_cache_.enabled()) {
+    ESP_LOGD(TAG, "Glyph cache: %u hits, %u misses", (unsigned) this->glyph_cache_.hits(),
+             (unsigned) this->glyph_cache_.misses());
+  }
+  
+#ifdef USE_SENSOR
+  // Moyennes de la fenêtre glissante, en millisecondes
+  if (this->render_time_sensor_ != nullptr) {
+    this->render_time_sensor_->publish_state(this->render_stat_.avg() / 1000.0f);
+  }
+  if (this->clear_time_sensor_ != nullptr) {
+    this->clear_time_sensor_->publish_state(this->clear_stat_.avg() / 1000.0f);
+  }
+  if (this->flush_time_sensor_ != nullptr) {
+    this->flush_time_sensor_->publish_state(this->flush_stat_.avg() / 1000.0f);
+  }
+  if (this->wait_time_sensor_ != nullptr) {
+    this->wait_time_sensor_->publish_state(this->wait_stat_.avg() / 1000.0f);
+  }
+  if (this->fps_sensor_ != nullptr) {
+    this->fps_sensor_->publish_state(fps);
+  }
+  if (this->bytes_per_frame_sensor_ != nullptr) {
+    this->bytes_per_frame_sensor_->publish_state(this->bytes_stat_.avg());
+  }
+#endif
+}
+
+bool ILI9881C::setup_present_task_() {
+  this->present_queue_ = xQueueCreate(1, sizeof(FrameJob));
+  this->present_done_ = xSemaphoreCreateBinary();
+  if (this->present_queue_ == nullptr || this->present_done_ == nullptr) {
+    return false;
+  }
+  // Aucune trame en cours au démarrage
+  xSemaphoreGive(this->present_done_);
+  
+  // Sur le second cœur lorsqu'il existe, la boucle principale reste libre
+  const BaseType_t core = portNUM_PROCESSORS > 1 ? 1 : tskNO_AFFINITY;
+  if (xTaskCreatePinnedToCore(ILI9881C::present_task_, "ili9881c_flush", 4096, this, 5,
+                              &this->present_task_handle_, core) != pdPASS) {
+    this->present_task_handle_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void ILI9881C::present_task_(void *arg) {
+  auto *self = static_cast<ILI9881C *>(arg);
+  FrameJob job;
+  while (true) {
+    if (xQueueReceive(self->present_queue_, &job, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    self->present_frame_(job);
+    xSemaphoreGive(self->present_done_);
+  }
+}
+
+bool ILI9881C::flush_area(int x1, int y1, int x2, int y2, const uint8_t *pixels, flush_area_callback_t &&done,
+                          BlitFormat format, bool big_endian) {
+#if SOC_MIPI_DSI_SUPPORTED
+  if (!this->initialized_ || pixels == nullptr) {
+    return false;
+  }
+  // Sinon le present de update() (ou d'une bande) écraserait les zones écrites
+  if (!this->external_flush_ || this->band_height_ > 0) {
+    ESP_LOGW(TAG, "flush_area requires external_flush and is not available in band rendering");
+    return false;
+  }
+  
+  // Bornes incluses -> borne haute exclue, puis offsets et clipping logiques
+  const uint8_t sbpp = blit_bytes_per_pixel(format);
+  const int ox = x1 + this->offset_x_;
+  const int oy = y1 + this->offset_y_;
+  FlushArea area;
+  area.stride = (size_t) (x2 - x1 + 1) * sbpp;
+  area.x1 = std::max(ox, 0);
+  area.y1 = std::max(oy, 0);
+  area.x2 = std::min(x2 + 1 + this->offset_x_, this->get_width_internal());
+  area.y2 = std::min(y2 + 1 + this->offset_y_, this->get_height_internal());
+  if (area.x1 >= area.x2 || area.y1 >= area.y2) {
+    if (done) {
+      done();
+    }
+    return true;
+  }
+  area.pixels = pixels + (size_t) (area.y1 - oy) * area.stride + (size_t) (area.x1 - ox) * sbpp;
+  area.format = format;
+  area.big_endian = big_endian;
+  area.done = std::move(done);
+  
+  if (this->area_task_handle_ == nullptr && !this->area_task_failed_ && !this->setup_area_task_()) {
+    ESP_LOGW(TAG, "Failed to start area flush task, flushing areas synchronously");
+    this->area_task_failed_ = true;
+  }
+  if (this->area_task_handle_ == nullptr) {
+    this->write_area_(area);
+    if (area.done) {
+      area.done();
+    }
+    return true;
+  }
+  
+  // Contre-pression : les deux emplacements sont en vol, attendre la fin d'un transfert
+  uint8_t slot;
+  xQueueReceive(this->area_free_, &slot, portMAX_DELAY);
+  this->area_slots_[slot] = std::move(area);
+  xQueueSend(this->area_queue_, &slot, 0);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool ILI9881C::setup_area_task_() {
+  this->area_queue_ = xQueueCreate(FLUSH_AREA_SLOTS, sizeof(uint8_t));
+  this->area_free_ = xQueueCreate(FLUSH_AREA_SLOTS, sizeof(uint8_t));
+  if (this->area_queue_ == nullptr || this->area_free_ == nullptr) {
+    return false;
+  }
+  for (uint8_t i = 0; i < FLUSH_AREA_SLOTS; i++) {
+    xQueueSend(this->area_free_, &i, 0);
+  }
+  
+  const BaseType_t core = portNUM_PROCESSORS > 1 ? 1 : tskNO_AFFINITY;
+  if (xTaskCreatePinnedToCore(ILI9881C::area_task_, "ili9881c_area", 4096, this, 5, &this->area_task_handle_,
+                              core) != pdPASS) {
+    this->area_task_handle_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void ILI9881C::area_task_(void *arg) {
+  auto *self = static_cast<ILI9881C *>(arg);
+  uint8_t slot;
+  while (true) {
+    if (xQueueReceive(self->area_queue_, &slot, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    FlushArea &area = self->area_slots_[slot];
+    self->write_area_(area);
+    // Emplacement rendu avant le callback : la bibliothèque peut enchaîner aussitôt
+    flush_area_callback_t done = std::move(area.done);
+    area.done = nullptr;
+    xQueueSend(self->area_free_, &slot, 0);
+    if (done) {
+      done();
+    }
+  }
+}
+
+void ILI9881C::write_area_(const FlushArea &area) {
+#if SOC_MIPI_DSI_SUPPORTED
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const size_t dst_stride = (size_t) this->display_width_ * bpp;
+  const int w = area.x2 - area.x1;
+  const int h = area.y2 - area.y1;
+  const bool bgr = this->color_order_ == COLOR_ORDER_BGR;
+  RowConvertFn convert = select_row_converter(area.format, area.big_endian, this->pixel_format_,
+                                              this->invert_colors_, bgr);
+  const uint8_t *src = area.pixels;
+  
+  if (this->rotation_ == ROTATION_0) {
+    // Conversion directe dans les lignes du framebuffer
+    uint8_t *dst = this->panel_fb_ + area.y1 * dst_stride + area.x1 * bpp;
+    for (int row = 0; row < h; row++, src += area.stride, dst += dst_stride) {
+      convert(src, dst, w);
+    }
+  } else {
+    // Par tranches de ROTATION_TILE lignes : conversion au format natif, puis transposé
+    const size_t tile_stride = (size_t) w * bpp;
+    if (this->area_tile_.size() < tile_stride * ROTATION_TILE) {
+      this->area_tile_.resize(tile_stride * ROTATION_TILE);
+    }
+    uint8_t *tile = this->area_tile_.data();
+    ptrdiff_t step_x, step_y;
+    rotation_steps(this->rotation_, bpp, dst_stride, step_x, step_y);
+    for (int ty = 0; ty < h; ty += ROTATION_TILE) {
+      const int th = std::min(ROTATION_TILE, h - ty);
+      for (int row = 0; row < th; row++, src += area.stride) {
+        uint8_t *line = tile + row * tile_stride;
+        if (area.format == BLIT_FORMAT_ARGB8888) {
+          // Le mélange alpha lit les pixels existants
+          int px, py;
+          rotate_point(this->rotation_, area.x1, area.y1 + ty + row, this->display_width_, this->display_height_,
+                       px, py);
+          const uint8_t *d = this->panel_fb_ + py * dst_stride + px * bpp;
+          for (int i = 0; i < w; i++, d += step_x) {
+            memcpy(line + i * bpp, d, bpp);
+          }
+        }
+        convert(src, line, w);
+      }
+      if (bpp == 2) {
+        rotate_tiles<2>(this->rotation_, tile, tile_stride, area.x1, area.y1 + ty, w, th, this->panel_fb_,
+                        dst_stride, this->display_width_, this->display_height_);
+      } else {
+        rotate_tiles<3>(this->rotation_, tile, tile_stride, area.x1, area.y1 + ty, w, th, this->panel_fb_,
+                        dst_stride, this->display_width_, this->display_height_);
+      }
+    }
+  }
+  
+  int px1 = area.x1, py1 = area.y1, px2 = area.x2, py2 = area.y2;
+  rotate_rect(this->rotation_, this->display_width_, this->display_height_, px1, py1, px2, py2);
+  this->sync_rect_(this->panel_fb_, dst_stride, px1, py1, px2, py2);
+#endif
+}
+
+uint8_t ILI9881C::build_flush_bands_(const DirtyRect *rects, uint8_t count, DirtyRect *bands) {
+  // esp_lcd_panel_draw_bitmap attend une source compacte : on envoie donc des
+  // bandes de lignes complètes, contiguës dans le buffer, couvrant les zones modifiées.
+  for (uint8_t i = 0; i < count; i++) {
+    bands[i] = rects[i];
+  }
+  
+  // Tri par y1 (insertion, au plus MAX_DIRTY_RECTS éléments)
+  for (uint8_t i = 1; i < count; i++) {
+    DirtyRect band = bands[i];
+    int j = i - 1;
+    while (j >= 0 && bands[j].y1 > band.y1) {
+      bands[j + 1] = bands[j];
+      j--;
+    }
+    bands[j + 1] = band;
+  }
+  
+  // Fusionner les bandes qui se chevauchent ou se touchent
+  uint8_t out = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (out > 0 && bands[i].y1 <= bands[out - 1].y2) {
+      bands[out - 1].y2 = std::max(bands[out - 1].y2, bands[i].y2);
+      continue;
+    }
+    bands[out] = bands[i];
+    bands[out].x1 = 0;
+    bands[out].x2 = this->get_buffer_width_();
+    out++;
+  }
+  return out;
+}
+
+void ILI9881C::flush_dirty_rects_(const FrameJob &job) {
+#if SOC_MIPI_DSI_SUPPORTED
+  const size_t row_bytes = (size_t) this->display_width_ * this->get_bytes_per_pixel_();
+  if (this->direct_framebuffer_) {
+    // Rendu direct : le pointeur est dans un framebuffer du driver. Seules les lignes
+    // de cache des zones modifiées sont réécrites, draw_bitmap (sur une ligne) ne
+    // sert plus qu'à basculer sur ce buffer
+    for (uint8_t i = 0; i < job.count; i++) {
+      const DirtyRect &r = job.rects[i];
+      this->sync_rect_(job.buffer, row_bytes, r.x1, r.y1, r.x2, r.y2);
+      this->bytes_flushed_ += (uint32_t) (r.x2 - r.x1) * (r.y2 - r.y1) * this->get_bytes_per_pixel_();
+    }
+    if (this->num_framebuffers_ > 1) {
+      const uint16_t y = job.rects[0].y1;
+      esp_err_t ret = esp_lcd_panel_draw_bitmap(this->dpi_panel_, 0, y, this->display_width_, y + 1, 
+        job.buffer + y * row_bytes);
+      if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to switch frame buffer: %s", esp_err_to_name(ret));
+      }
+    }
+    return;
+  }
+  
+  DirtyRect bands[MAX_DIRTY_RECTS];
+  uint8_t count = this->build_flush_bands_(job.rects, job.count, bands);
+  
+  // Dans la zone de défilement, une bande peut être en deux morceaux en mémoire
+  for (uint8_t i = 0; i < count; i++) {
+    for (int y1 = bands[i].y1; y1 < bands[i].y2;) {
+      const int y2 = this->row_run_end_(y1, bands[i].y2, job.scroll_offset);
+      esp_err_t ret = esp_lcd_panel_draw_bitmap(this->dpi_panel_, 
+        0, y1, this->display_width_, y2, job.buffer + this->map_row_(y1, job.scroll_offset) * row_bytes);
+      if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to draw bitmap: %s", esp_err_to_name(ret));
+        return;
+      }
+      this->bytes_flushed_ += (y2 - y1) * row_bytes;
+      y1 = y2;
+    }
+  }
+#endif
+}
+
+void ILI9881C::swap_framebuffers_(const DirtyRect *bands, uint8_t count) {
+  // Historique des zones modifiées : le nouveau back buffer a manqué les
+  // (num_framebuffers_ - 1) dernières trames.
+  for (uint8_t h = this->num_framebuffers_ - 2; h > 0; h--) {
+    this->history_count_[h] = this->history_count_[h - 1];
+    memcpy(this->history_[h], this->history_[h - 1], sizeof(this->history_[h]));
+  }
+  this->history_count_[0] = count;
+  memcpy(this->history_[0], bands, count * sizeof(DirtyRect));
+  
+  uint8_t front = this->back_buffer_;
+  this->back_buffer_ = (this->back_buffer_ + 1) % this->num_framebuffers_;
+  this->buffer_ = this->framebuffers_[this->back_buffer_];
+  
+  // Avec l'auto-clear, la trame suivante est entièrement redessinée
+  if (this->auto_clear_enabled_) {
+    return;
+  }
+  
+  // Recopier depuis le front buffer les lignes modifiées depuis la dernière
+  // utilisation de ce buffer, pour que le rendu partiel parte d'une image à jour.
+  // Le front buffer peut être en cours de transfert : il n'est que lu.
+  const size_t row_bytes = (size_t) this->get_buffer_width_() * this->get_bytes_per_pixel_();
+  for (uint8_t h = 0; h < this->num_framebuffers_ - 1; h++) {
+    for (uint8_t i = 0; i < this->history_count_[h]; i++) {
+      const DirtyRect &band = this->history_[h][i];
+      size_t offset = band.y1 * row_bytes;
+      size_t len = (band.y2 - band.y1) * row_bytes;
+      memcpy(this->buffer_ + offset, this->framebuffers_[front] + offset, len);
+#if SOC_MIPI_DSI_SUPPORTED
+      if (this->direct_framebuffer_) {
+        esp_cache_msync(this->buffer_ + offset, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+      }
+#endif
+    }
+  }
+}
+
+bool ILI9881C::setup_framebuffers_() {
+#if SOC_MIPI_DSI_SUPPORTED
+  if (this->external_flush_) {
+    // flush_area() écrit dans l'unique framebuffer du driver DPI : aucun buffer de rendu
+    void *fb = nullptr;
+    esp_err_t ret = esp_lcd_dpi_panel_get_frame_buffer(this->dpi_panel_, 1, &fb);
+    if (ret != ESP_OK) {
+      ESP_LOGE(TAG, "Failed to get DPI frame buffer: %s", esp_err_to_name(ret));
+      return false;
+    }
+    this->panel_fb_ = static_cast<uint8_t *>(fb);
+    ESP_LOGD(TAG, "External flush, no render buffer");
+    return true;
+  }
+#endif
+  
+  if (this->band_height_ > 0) {
+    // Deux bandes seulement, le framebuffer complet n'existe que dans le driver DPI
+    const size_t band_size = (size_t) this->get_buffer_width_() * this->band_height_ * this->get_bytes_per_pixel_();
+    for (uint8_t i = 0; i < 2; i++) {
+      this->band_buffers_[i] = this->allocate_render_buffer_(band_size);
+      if (this->band_buffers_[i] == nullptr) {
+        return false;
+      }
+    }
+    this->buffer_ = this->band_buffers_[0];
+    this->set_band_(0, std::min<int>(this->band_height_, this->get_buffer_height_()));
+    ESP_LOGD(TAG, "Rendering in bands of %u lines (2 x %u bytes)", this->band_height_, (unsigned) band_size);
+    return true;
+  }
+  
+  if (!this->direct_framebuffer_) {
+    // Calculer la taille du buffer
+    size_t buffer_size = this->get_buffer_length_internal_();
+    this->buffer_ = this->allocate_render_buffer_(buffer_size);
+    if (this->buffer_ == nullptr) {
+      return false;
+    }
+    if (this->async_present_) {
+      // Second buffer de rendu : la trame N+1 est dessinée pendant le transfert de N
+      uint8_t *second = this->allocate_render_buffer_(buffer_size);
+      if (second == nullptr) {
+        ESP_LOGW(TAG, "No memory for a second render buffer");
+      } else {
+        this->framebuffers_[0] = this->buffer_;
+        this->framebuffers_[1] = second;
+        this->num_framebuffers_ = 2;
+        this->back_buffer_ = 0;
+      }
+    }
+    if (this->rotate_on_flush_()) {
+      return this->setup_flush_rotation_();
+    }
+    return true;
+  }
+  
+#if SOC_MIPI_DSI_SUPPORTED
+  // Rendu direct dans les framebuffers alloués par le driver DPI
+  void *fbs[MAX_FRAMEBUFFERS] = {nullptr};
+  esp_err_t ret = esp_lcd_dpi_panel_get_frame_buffer(this->dpi_panel_, this->num_framebuffers_, 
+    &fbs[0], &fbs[1], &fbs[2]);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to get DPI frame buffers: %s", esp_err_to_name(ret));
+    return false;
+  }
+  for (uint8_t i = 0; i < this->num_framebuffers_; i++) {
+    this->framebuffers_[i] = static_cast<uint8_t *>(fbs[i]);
+  }
+  
+  // Le driver affiche le buffer 0 au démarrage
+  this->back_buffer_ = this->num_framebuffers_ > 1 ? 1 : 0;
+  this->buffer_ = this->framebuffers_[this->back_buffer_];
+  ESP_LOGD(TAG, "Rendering directly into %d DPI frame buffer(s)", this->num_framebuffers_);
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint8_t *ILI9881C::allocate_render_buffer_(size_t length) {
+  // Début et fin alignés sur une ligne de cache : le write-back ne déborde jamais
+  // sur une autre allocation et le PPA accepte le buffer
+  const size_t size = (length + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+  const uint32_t psram = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+  const uint32_t internal = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT;
+  void *buffer = nullptr;
+  switch (this->framebuffer_memory_) {
+    case FRAMEBUFFER_MEMORY_PSRAM:
+      buffer = heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, psram);
+      break;
+    case FRAMEBUFFER_MEMORY_INTERNAL:
+      buffer = heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, internal);
+      break;
+    case FRAMEBUFFER_MEMORY_AUTO:
+    default:
+      // Les bandes, petites et réécrites en entier à chaque trame, vont d'abord en SRAM interne
+      if (this->band_height_ > 0) {
+        buffer = heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, internal);
+      }
+      if (buffer == nullptr) {
+        buffer = heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, psram);
+      }
+      if (buffer == nullptr && this->band_height_ == 0) {
+        buffer = heap_caps_aligned_calloc(BUFFER_ALIGN, 1, size, internal);
+      }
+      break;
+  }
+  if (buffer == nullptr) {
+    ESP_LOGE(TAG, "Failed to allocate %u bytes for the render buffer", (unsigned) size);
+    return nullptr;
+  }
+  // Buffer neuf à la couleur de fond encodée (blanche en couleurs inversées), comme
+  // le clear() de DisplayBuffer
+  this->fill_off_(static_cast<uint8_t *>(buffer), length);
+  return static_cast<uint8_t *>(buffer);
+}
+
+void ILI9881C::fill_off_(uint8_t *buffer, size_t length) {
+  uint8_t pixel[4];
+  this->pixel_encoder_(pixel, 0, 0, COLOR_OFF);
+  fill_span(buffer, length / this->get_bytes_per_pixel_(), pixel, this->get_bytes_per_pixel_());
+}
+
+void ILI9881C::sync_rect_(uint8_t *base, size_t stride, int x1, int y1, int x2, int y2) {
+#if SOC_MIPI_DSI_SUPPORTED
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const size_t span = (size_t) (x2 - x1) * bpp;
+  if (span * 4 < stride) {
+    // Zone étroite : ligne par ligne, les lignes de cache voisines ne sont pas réécrites
+    for (int y = y1; y < y2; y++) {
+      esp_cache_msync(base + y * stride + x1 * bpp, span, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    }
+    return;
+  }
+  // Une seule plage, du premier au dernier octet modifié
+  const size_t start = y1 * stride + x1 * bpp;
+  const size_t end = (y2 - 1) * stride + x2 * bpp;
+  esp_cache_msync(base + start, end - start, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#endif
+}
+
+bool ILI9881C::setup_flush_rotation_() {
+#if SOC_MIPI_DSI_SUPPORTED
+  // Le transposé écrit directement dans le framebuffer du driver DPI
+  void *fb = nullptr;
+  esp_err_t ret = esp_lcd_dpi_panel_get_frame_buffer(this->dpi_panel_, 1, &fb);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to get DPI frame buffer: %s", esp_err_to_name(ret));
+    return false;
+  }
+  this->panel_fb_ = static_cast<uint8_t *>(fb);
+  
+#if SOC_PPA_SUPPORTED
+  ppa_client_config_t ppa_config = {};
+  ppa_config.oper_type = PPA_OPERATION_SRM;
+  ppa_config.max_pending_trans_num = 1;
+  ret = ppa_register_client(&ppa_config, &this->ppa_srm_);
+  if (ret != ESP_OK) {
+    ESP_LOGW(TAG, "PPA unavailable, rotating on the CPU: %s", esp_err_to_name(ret));
+    this->ppa_srm_ = nullptr;
+  }
+#endif
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ILI9881C::flush_rotated_(const FrameJob &job) {
+#if SOC_MIPI_DSI_SUPPORTED
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const int bw = this->get_buffer_width_();
+  const size_t src_stride = (size_t) bw * bpp;
+  const size_t dst_stride = (size_t) this->display_width_ * bpp;
+  
+  for (uint8_t i = 0; i < job.count; i++) {
+    const DirtyRect &r = job.rects[i];
+    const int w = r.x2 - r.x1;
+    const int h = r.y2 - r.y1;
+    int px1 = r.x1, py1 = r.y1, px2 = r.x2, py2 = r.y2;
+    rotate_rect(this->rotation_, this->display_width_, this->display_height_, px1, py1, px2, py2);
+    
+#if SOC_PPA_SUPPORTED
+    if (this->ppa_srm_ != nullptr) {
+      // Le PPA tourne dans le sens anti-horaire
+      static const ppa_srm_rotation_angle_t PPA_ANGLES[] = {
+        PPA_SRM_ROTATION_ANGLE_0, PPA_SRM_ROTATION_ANGLE_270, PPA_SRM_ROTATION_ANGLE_180, PPA_SRM_ROTATION_ANGLE_90,
+      };
+      // Le RGB666 est stocké en RGB888 : copie à l'identique
+      const ppa_srm_color_mode_t cm = this->pixel_format_ == PIXEL_FORMAT_RGB565 ? PPA_SRM_COLOR_MODE_RGB565
+                                                                                  : PPA_SRM_COLOR_MODE_RGB888;
+      ppa_srm_oper_config_t srm = {};
+      srm.in.buffer = job.buffer;
+      srm.in.pic_w = bw;
+      srm.in.pic_h = this->get_buffer_height_();
+      srm.in.block_w = w;
+      srm.in.block_h = h;
+      srm.in.block_offset_x = r.x1;
+      srm.in.block_offset_y = r.y1;
+      srm.in.srm_cm = cm;
+      srm.out.buffer = this->panel_fb_;
+      srm.out.buffer_size = this->get_buffer_length_internal_();
+      srm.out.pic_w = this->display_width_;
+      srm.out.pic_h = this->display_height_;
+      srm.out.block_offset_x = px1;
+      srm.out.block_offset_y = py1;
+      srm.out.srm_cm = cm;
+      srm.rotation_angle = PPA_ANGLES[this->rotation_];
+      srm.scale_x = 1.0f;
+      srm.scale_y = 1.0f;
+      srm.mode = PPA_TRANS_MODE_BLOCKING;
+      if (ppa_do_scale_rotate_mirror(this->ppa_srm_, &srm) == ESP_OK) {
+        this->bytes_flushed_ += (uint32_t) w * h * bpp;
+        continue;
+      }
+      ESP_LOGW(TAG, "PPA rotation failed, falling back to the CPU");
+    }
+#endif
+    
+    // Transposé par tuiles sur le CPU, puis réécriture du cache des lignes touchées
+    if (bpp == 2) {
+      rotate_block<2>(this->rotation_, job.buffer, src_stride, r.x1, r.y1, w, h, this->panel_fb_, dst_stride,
+                      this->display_width_, this->display_height_);
+    } else {
+      rotate_block<3>(this->rotation_, job.buffer, src_stride, r.x1, r.y1, w, h, this->panel_fb_, dst_stride,
+                      this->display_width_, this->display_height_);
+    }
+    this->sync_rect_(this->panel_fb_, dst_stride, px1, py1, px2, py2);
+    this->bytes_flushed_ += (uint32_t) w * h * bpp;
+  }
+#endif
+}
+
+void ILI9881C::mark_dirty_(int x1, int y1, int x2, int y2) {
+  x1 = std::max(x1, 0);
+  y1 = std::max(y1, 0);
+  x2 = std::min(x2, this->get_buffer_width_());
+  y2 = std::min(y2, this->get_buffer_height_());
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+  
+  // Dessin dans un calque : sa zone de contenu s'étend
+  if (this->active_layer_ != LAYER_MAIN) {
+    const bool background = this->active_layer_ == LAYER_BACKGROUND;
+    DirtyRect &bounds = background ? this->background_bounds_ : this->overlays_[this->active_layer_].bounds;
+    bool &has_content = background ? this->background_drawn_ : this->overlays_[this->active_layer_].has_content;
+    if (!has_content) {
+      bounds = {(uint16_t) x1, (uint16_t) y1, (uint16_t) x2, (uint16_t) y2};
+      has_content = true;
+    } else {
+      bounds.x1 = std::min<int>(bounds.x1, x1);
+      bounds.y1 = std::min<int>(bounds.y1, y1);
+      bounds.x2 = std::max<int>(bounds.x2, x2);
+      bounds.y2 = std::max<int>(bounds.y2, y2);
+    }
+  }
+  
+  // Déjà couvert par une zone existante ?
+  for (uint8_t i = 0; i < this->dirty_count_; i++) {
+    const DirtyRect &r = this->dirty_rects_[i];
+    if (x1 >= r.x1 && x2 <= r.x2 && y1 >= r.y1 && y2 <= r.y2) {
+      this->last_dirty_ = i;
+      return;
+    }
+  }
+  
+  // Zone voisine : on l'agrandit
+  for (uint8_t i = 0; i < this->dirty_count_; i++) {
+    DirtyRect &r = this->dirty_rects_[i];
+    if (x1 <= r.x2 + DIRTY_MERGE_GAP && x2 + DIRTY_MERGE_GAP >= r.x1 &&
+        y1 <= r.y2 + DIRTY_MERGE_GAP && y2 + DIRTY_MERGE_GAP >= r.y1) {
+      r.x1 = std::min<int>(r.x1, x1);
+      r.y1 = std::min<int>(r.y1, y1);
+      r.x2 = std::max<int>(r.x2, x2);
+      r.y2 = std::max<int>(r.y2, y2);
+      this->merge_dirty_rect_(i);
+      return;
+    }
+  }
+  
+  if (this->dirty_count_ < MAX_DIRTY_RECTS) {
+    this->dirty_rects_[this->dirty_count_] = {(uint16_t) x1, (uint16_t) y1, (uint16_t) x2, (uint16_t) y2};
+    this->last_dirty_ = this->dirty_count_++;
+    return;
+  }
+  
+  // Liste pleine : fusionner avec la zone dont l'aire augmente le moins
+  uint8_t best = 0;
+  uint32_t best_growth = UINT32_MAX;
+  for (uint8_t i = 0; i < this->dirty_count_; i++) {
+    const DirtyRect &r = this->dirty_rects_[i];
+    uint32_t area = (uint32_t) (r.x2 - r.x1) * (r.y2 - r.y1);
+    uint32_t merged = (uint32_t) (std::max<int>(r.x2, x2) - std::min<int>(r.x1, x1)) *
+                      (std::max<int>(r.y2, y2) - std::min<int>(r.y1, y1));
+    if (merged - area < best_growth) {
+      best_growth = merged - area;
+      best = i;
+    }
+  }
+  DirtyRect &r = this->dirty_rects_[best];
+  r.x1 = std::min<int>(r.x1, x1);
+  r.y1 = std::min<int>(r.y1, y1);
+  r.x2 = std::max<int>(r.x2, x2);
+  r.y2 = std::max<int>(r.y2, y2);
+  this->merge_dirty_rect_(best);
+}
+
+void ILI9881C::merge_dirty_rect_(uint8_t index) {
+  // Absorber les zones que le rectangle agrandi touche désormais
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    DirtyRect &r = this->dirty_rects_[index];
+    for (uint8_t j = 0; j < this->dirty_count_; j++) {
+      if (j == index) {
+        continue;
+      }
+      const DirtyRect &o = this->dirty_rects_[j];
+      if (o.x1 <= r.x2 + DIRTY_MERGE_GAP && o.x2 + DIRTY_MERGE_GAP >= r.x1 &&
+          o.y1 <= r.y2 + DIRTY_MERGE_GAP && o.y2 + DIRTY_MERGE_GAP >= r.y1) {
+        r.x1 = std::min(r.x1, o.x1);
+        r.y1 = std::min(r.y1, o.y1);
+        r.x2 = std::max(r.x2, o.x2);
+        r.y2 = std::max(r.y2, o.y2);
+        // Retirer j en le remplaçant par le dernier élément
+        uint8_t last = --this->dirty_count_;
+        if (index == last) {
+          index = j;
+        }
+        this->dirty_rects_[j] = this->dirty_rects_[last];
+        merged = true;
+        break;
+      }
+    }
+  }
+  this->last_dirty_ = index;
+}
+
+void ILI9881C::draw_absolute_pixel_internal(int x, int y, Color color) {
+  // Aucun buffer avant la fin de la mise en route (ni en flush externe)
+  if (this->buffer_ == nullptr) {
+    return;
+  }
+  (this->*draw_pixel_fn_)(x, y, color);
+}
+
+template<Rotation ROT> void ILI9881C::draw_pixel_(int x, int y, Color color) {
+  // Appliquer l'offset (coordonnées logiques)
+  x += this->offset_x_;
+  y += this->offset_y_;
+  
+  // Vérifier les limites logiques ; en rotation au flush, ROT vaut 0 et le buffer est logique
+  const int bw = this->get_buffer_width_();
+  const int bh = this->get_buffer_height_();
+  const int lw = rotation_swaps_axes(ROT) ? bh : bw;
+  const int lh = rotation_swaps_axes(ROT) ? bw : bh;
+  if ((unsigned) x >= (unsigned) lw || (unsigned) y >= (unsigned) lh) {
+    return;
+  }
+  
+  int pixel_x, pixel_y;
+  rotate_point(ROT, x, y, bw, bh, pixel_x, pixel_y);
+  if (this->band_height_ > 0 && (unsigned) (pixel_y - this->band_top_) >= (unsigned) this->band_rows_) {
+    return;
+  }
+  
+  // L'ordre des couleurs et l'inversion sont résolus à la compilation
+  const size_t pos = ((size_t) this->map_row_(pixel_y) * bw + pixel_x) * this->get_bytes_per_pixel_();
+  this->pixel_writer_(this->buffer_ + pos, pixel_x, pixel_y, color);
+  
+  // Suivi des zones modifiées (chemin rapide : pixel dans la dernière zone touchée) ;
+  // dans un calque, mark_dirty_ doit aussi étendre ses bornes
+  const DirtyRect &last = this->dirty_rects_[this->last_dirty_];
+  if (this->active_layer_ != LAYER_MAIN || this->dirty_count_ == 0 || pixel_x < last.x1 || pixel_x >= last.x2 ||
+      pixel_y < last.y1 || pixel_y >= last.y2) {
+    this->mark_dirty_(pixel_x, pixel_y, pixel_x + 1, pixel_y + 1);
+  }
+}
 
-void ILI9881C::add_init_delay(uint16_t delay_ms) {
-  InitCommand init_cmd;
-  init_cmd.cmd = 0;
-  init_cmd.data = {};
-  init_cmd.delay_ms = delay_ms;
-  init_cmd.is_delay = true;
-  this->init_commands_.push_back(init_cmd);
+void ILI9881C::fill(Color color) {
+  this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color);
 }
 
-void ILI9881C::clear_init_sequence() {
-  this->init_commands_.clear();
+void ILI9881C::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  if (this->buffer_ == nullptr) {
+    return;
+  }
+  // Rotation logicielle de DisplayBuffer : chemin générique
+  if (this->display::Display::rotation_ != display::DISPLAY_ROTATION_0_DEGREES) {
+    display::Display::filled_rectangle(x1, y1, width, height, color);
+    return;
+  }
+  
+  int x2 = x1 + width;
+  int y2 = y1 + height;
+  if (!this->clip_rect_(x1, y1, x2, y2)) {
+    return;
+  }
+  this->fill_rect_(x1, y1, x2, y2, color);
+}
+
+void ILI9881C::horizontal_line(int x, int y, int width, Color color) {
+  this->filled_rectangle(x, y, width, 1, color);
+}
+
+void ILI9881C::vertical_line(int x, int y, int height, Color color) {
+  this->filled_rectangle(x, y, 1, height, color);
+}
+
+bool ILI9881C::clip_logical_rect_(int &x1, int &y1, int &x2, int &y2) {
+  // Même clipping que DisplayBuffer::draw_pixel_at, puis offset et bornes logiques
+  display::Rect clip = this->get_clipping();
+  if (clip.is_set()) {
+    x1 = std::max(x1, (int) clip.x);
+    y1 = std::max(y1, (int) clip.y);
+    x2 = std::min(x2, (int) clip.x2());
+    y2 = std::min(y2, (int) clip.y2());
+  }
+  x1 = std::max(x1 + this->offset_x_, 0);
+  y1 = std::max(y1 + this->offset_y_, 0);
+  x2 = std::min(x2 + this->offset_x_, this->get_width_internal());
+  y2 = std::min(y2 + this->offset_y_, this->get_height_internal());
+  // Rendu par bandes : seule la bande en cours existe en mémoire
+  if (this->band_height_ > 0) {
+    x1 = std::max<int>(x1, this->band_clip_.x1);
+    y1 = std::max<int>(y1, this->band_clip_.y1);
+    x2 = std::min<int>(x2, this->band_clip_.x2);
+    y2 = std::min<int>(y2, this->band_clip_.y2);
+  }
+  return x1 < x2 && y1 < y2;
+}
+
+bool ILI9881C::clip_rect_(int &x1, int &y1, int &x2, int &y2) {
+  if (!this->clip_logical_rect_(x1, y1, x2, y2)) {
+    return false;
+  }
+  // Coordonnées du buffer de rendu
+  if (!this->rotate_on_flush_()) {
+    rotate_rect(this->rotation_, this->display_width_, this->display_height_, x1, y1, x2, y2);
+  }
+  return true;
+}
+
+void ILI9881C::blit(int x, int y, int w, int h, const uint8_t *src, size_t src_stride, BlitFormat format,
+                    bool big_endian) {
+  if (this->buffer_ == nullptr || src == nullptr) {
+    return;
+  }
+  int x1 = x, y1 = y, x2 = x + w, y2 = y + h;
+  if (!this->clip_logical_rect_(x1, y1, x2, y2)) {
+    return;
+  }
+  
+  const uint8_t sbpp = blit_bytes_per_pixel(format);
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const bool bgr = this->color_order_ == COLOR_ORDER_BGR;
+  RowConvertFn convert = select_row_converter(format, big_endian, this->pixel_format_, this->invert_colors_, bgr);
+  
+  // Position du premier pixel visible dans la source
+  src += (size_t) (y1 - (y + this->offset_y_)) * src_stride + (size_t) (x1 - (x + this->offset_x_)) * sbpp;
+  const int count = x2 - x1;
+  
+  // Pas dans le buffer de rendu pour x+1 / y+1 logiques
+  const Rotation rot = this->rotate_on_flush_() ? ROTATION_0 : this->rotation_;
+  const int bw = this->get_buffer_width_();
+  const int bh = this->get_buffer_height_();
+  const size_t stride = (size_t) bw * bpp;
+  ptrdiff_t step_x, step_y;
+  rotation_steps(rot, bpp, stride, step_x, step_y);
+  int px, py;
+  rotate_point(rot, x1, y1, bw, bh, px, py);
+  uint8_t *dst = this->buffer_ + (size_t) this->map_row_(py) * stride + px * bpp;
+  
+  if (step_x == bpp) {
+    // Lignes contiguës (rotation 0) : conversion directe dans le framebuffer
+    for (int row = py; row < py + y2 - y1; row++) {
+      convert(src, this->buffer_ + (size_t) this->map_row_(row) * stride + px * bpp, count);
+      src += src_stride;
+    }
+  } else {
+    // Rotation : conversion dans une ligne temporaire, puis dispersion
+    const size_t line_bytes = (size_t) count * bpp;
+    if (this->line_buffer_.size() < line_bytes) {
+      this->line_buffer_.resize(line_bytes);
+    }
+    uint8_t *line = this->line_buffer_.data();
+    for (int row = y1; row < y2; row++) {
+      uint8_t *d = dst;
+      if (format == BLIT_FORMAT_ARGB8888) {
+        // Le mélange alpha lit les pixels existants
+        for (int i = 0; i < count; i++, d += step_x) {
+          memcpy(line + i * bpp, d, bpp);
+        }
+        d = dst;
+      }
+      convert(src, line, count);
+      for (int i = 0; i < count; i++, d += step_x) {
+        memcpy(d, line + i * bpp, bpp);
+      }
+      src += src_stride;
+      dst += step_y;
+    }
+  }
+  
+  if (!this->rotate_on_flush_()) {
+    rotate_rect(this->rotation_, this->display_width_, this->display_height_, x1, y1, x2, y2);
+  }
+  this->mark_dirty_(x1, y1, x2, y2);
+}
+
+void ILI9881C::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                              display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  if (this->buffer_ == nullptr) {
+    return;
+  }
+  // Formats pris en charge par blit(), sinon chemin générique pixel par pixel
+  BlitFormat format;
+  bool be = big_endian;
+  if (bitness == display::COLOR_BITNESS_565 && order == display::COLOR_ORDER_RGB) {
+    format = BLIT_FORMAT_RGB565;
+  } else if (bitness == display::COLOR_BITNESS_888 && order != display::COLOR_ORDER_GRB) {
+    format = BLIT_FORMAT_RGB888;
+    be = order == display::COLOR_ORDER_RGB;
+  } else {
+    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                     x_pad);
+    return;
+  }
+  
+  const uint8_t sbpp = blit_bytes_per_pixel(format);
+  const size_t src_stride = (size_t) (x_offset + w + x_pad) * sbpp;
+  this->blit(x_start, y_start, w, h, ptr + y_offset * src_stride + x_offset * sbpp, src_stride, format, be);
+}
+
+void ILI9881C::fill_rect_(int x1, int y1, int x2, int y2, Color color) {
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const int bw = this->get_buffer_width_();
+  const size_t row_bytes = (size_t) bw * bpp;
+  const size_t span = x2 - x1;
+  
+  if (this->pixel_writer_ != this->pixel_encoder_) {
+    // Le tramage dépend de la position : écriture pixel par pixel
+    for (int y = y1; y < y2; y++) {
+      uint8_t *dst = this->buffer_ + this->map_row_(y) * row_bytes + x1 * bpp;
+      for (int x = x1; x < x2; x++) {
+        this->pixel_writer_(dst, x, y, color);
+        dst += bpp;
+      }
+    }
+  } else {
+    uint8_t pixel[3];
+    this->pixel_encoder_(pixel, 0, 0, color);
+    // Par plages de lignes contiguës en mémoire (une seule hors zone de défilement)
+    for (int y = y1; y < y2;) {
+      const int end = this->row_run_end_(y, y2, this->scroll_offset_);
+      const int py1 = this->map_row_(y);
+      const int py2 = py1 + end - y;
+      if (this->fill_rect_ppa_(x1, py1, x2, py2, pixel)) {
+        // Rempli par le moteur 2D-DMA
+      } else if (x1 == 0 && x2 == bw) {
+        // Lignes complètes : une seule plage contiguë
+        fill_span(this->buffer_ + py1 * row_bytes, span * (py2 - py1), pixel, bpp);
+      } else {
+        for (int py = py1; py < py2; py++) {
+          fill_span(this->buffer_ + py * row_bytes + x1 * bpp, span, pixel, bpp);
+        }
+      }
+      y = end;
+    }
+  }
+  
+  this->mark_dirty_(x1, y1, x2, y2);
+}
+
+bool ILI9881C::fill_rect_ppa_(int x1, int y1, int x2, int y2, const uint8_t *pixel) {
+#if SOC_PPA_SUPPORTED
+  // Une bande en SRAM interne se remplit plus vite au CPU qu'avec une transaction PPA
+  if (this->ppa_fill_ == nullptr || this->band_height_ > 0 ||
+      (uint32_t) (x2 - x1) * (y2 - y1) < PPA_FILL_MIN_PIXELS) {
+    return false;
+  }
+  // Motifs uniformes uniquement : l'ordre des composantes écrit par le PPA est alors
+  // indifférent ; en RGB565, seuls le noir et le blanc sont des gris exacts
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  if (pixel[0] != pixel[1] || (bpp == 3 && pixel[1] != pixel[2]) ||
+      (bpp == 2 && pixel[0] != 0x00 && pixel[0] != 0xFF)) {
+    return false;
+  }
+  
+  ppa_fill_oper_config_t fill = {};
+  fill.out.buffer = this->buffer_;
+  fill.out.buffer_size = this->get_buffer_length_internal_();
+  fill.out.pic_w = this->get_buffer_width_();
+  fill.out.pic_h = this->get_buffer_height_();
+  fill.out.block_offset_x = x1;
+  fill.out.block_offset_y = y1;
+  fill.out.fill_cm = bpp == 2 ? PPA_FILL_COLOR_MODE_RGB565 : PPA_FILL_COLOR_MODE_RGB888;
+  fill.fill_block_w = x2 - x1;
+  fill.fill_block_h = y2 - y1;
+  fill.fill_argb_color.val = 0xFF000000 | pixel[0] * 0x010101u;
+  fill.mode = PPA_TRANS_MODE_BLOCKING;
+  esp_err_t ret = ppa_do_fill(this->ppa_fill_, &fill);
+  if (ret != ESP_OK) {
+    // Typiquement un buffer non aligné sur les lignes de cache : ce remplissage seul
+    // passe au CPU, les autres buffers gardent le PPA
+    ESP_LOGV(TAG, "PPA fill rejected, filling on the CPU: %s", esp_err_to_name(ret));
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool ILI9881C::set_scroll_region(uint16_t top, uint16_t height) {
+  if (height == 0) {
+    this->unroll_scroll_region_();
+    this->scroll_height_ = 0;
+    return true;
+  }
+  // L'anneau porte sur les lignes d'un unique buffer copié vers le panel, en orientation
+  // native, et son contenu est conservé d'une trame à l'autre
+  const char *reason = nullptr;
+  if (height < 2 || top + height > this->get_buffer_height_()) {
+    reason = "region outside the frame buffer";
+  } else if (this->direct_framebuffer_ || this->num_framebuffers_ > 1 || this->band_height_ > 0) {
+    reason = "requires a single render buffer copied to the panel";
+  } else if (this->rotation_ != ROTATION_0 || this->display::Display::rotation_ != display::DISPLAY_ROTATION_0_DEGREES) {
+    reason = "requires rotation 0";
+  } else if (this->auto_clear_enabled_) {
+    reason = "requires auto_clear_enabled: false";
+  } else if (this->background_ != nullptr || this->num_overlays_ > 0) {
+    reason = "cannot be combined with layers";
+  }
+  if (reason != nullptr) {
+    ESP_LOGW(TAG, "Scroll region %u+%u rejected: %s", top, height, reason);
+    return false;
+  }
+  
+  this->unroll_scroll_region_();
+  this->scroll_top_ = top;
+  this->scroll_height_ = height;
+  return true;
+}
+
+void ILI9881C::unroll_scroll_region_() {
+  // Remettre les lignes dans l'ordre avant de changer ou supprimer la zone
+  if (this->scroll_offset_ != 0 && this->buffer_ != nullptr) {
+    const size_t row_bytes = (size_t) this->get_buffer_width_() * this->get_bytes_per_pixel_();
+    uint8_t *first = this->buffer_ + this->scroll_top_ * row_bytes;
+    std::rotate(first, first + this->scroll_offset_ * row_bytes, first + this->scroll_height_ * row_bytes);
+  }
+  this->scroll_offset_ = 0;
+}
+
+void ILI9881C::scroll(int lines) {
+  if (this->buffer_ == nullptr || this->scroll_height_ == 0 || lines == 0) {
+    return;
+  }
+  const int height = this->scroll_height_;
+  const int top = this->scroll_top_;
+  const int bottom = top + height;
+  const int bw = this->get_buffer_width_();
+  this->scroll_offset_ = (this->scroll_offset_ + lines % height + height) % height;
+  
+  // Les lignes sorties d'un côté réapparaissent de l'autre : elles sont effacées
+  const int exposed = std::min(std::abs(lines), height);
+  if (lines > 0) {
+    this->fill_rect_(0, bottom - exposed, bw, bottom, COLOR_OFF);
+  } else {
+    this->fill_rect_(0, top, bw, top + exposed, COLOR_OFF);
+  }
+  // Toute la zone a bougé à l'écran ; seul le transfert vers le panel la parcourt
+  this->mark_dirty_(0, top, bw, bottom);
+}
+
+int ILI9881C::row_run_end_(int y, int y2, uint16_t offset) const {
+  const int top = this->scroll_top_;
+  const int bottom = top + this->scroll_height_;
+  if (this->scroll_height_ == 0 || y >= bottom) {
+    return y2;
+  }
+  if (y < top) {
+    return std::min(y2, top);
+  }
+  // Jusqu'au bouclage de l'anneau ou à la fin de la zone
+  const int wrap = y + (bottom - this->map_row_(y, offset));
+  return std::min(y2, std::min(wrap, bottom));
+}
+
+void ILI9881C::print(int x, int y, display::BaseFont *font, Color color, display::TextAlign align, const char *text,
+                     Color background) {
+  // Le cache suppose un buffer en orientation logique, sans rotation logicielle
+  const bool cacheable = this->glyph_cache_.enabled() && (this->rotation_ == ROTATION_0 || this->rotate_on_flush_()) &&
+                         this->display::Display::rotation_ == display::DISPLAY_ROTATION_0_DEGREES;
+  if (!cacheable || font == nullptr || text == nullptr) {
+    display::Display::print(x, y, font, color, align, text, background);
+    return;
+  }
+  
+  int x_start, y_start, width, height;
+  this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+  
+  // Un caractère UTF-8 à la fois, à la position où la police l'aurait tracé
+  char glyph[5];
+  int pen = x_start;
+  for (const char *p = text; *p != '\0';) {
+    const uint8_t lead = *p;
+    const int expected = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 1;
+    int len = 0;
+    while (len < expected && p[len] != '\0') {
+      glyph[len] = p[len];
+      len++;
+    }
+    glyph[len] = '\0';
+    p += len;
+    pen += this->draw_cached_glyph_(pen, y_start, font, color, background, glyph);
+  }
+}
+
+void ILI9881C::print(int x, int y, display::BaseFont *font, Color color, const char *text, Color background) {
+  this->print(x, y, font, color, display::TextAlign::TOP_LEFT, text, background);
+}
+
+void ILI9881C::printf(int x, int y, display::BaseFont *font, Color color, display::TextAlign align, const char *format,
+                      ...) {
+  char buffer[256];
+  va_list arg;
+  va_start(arg, format);
+  int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
+  va_end(arg);
+  if (ret > 0) {
+    this->print(x, y, font, color, align, buffer);
+  }
+}
+
+void ILI9881C::printf(int x, int y, display::BaseFont *font, Color color, const char *format, ...) {
+  char buffer[256];
+  va_list arg;
+  va_start(arg, format);
+  int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
+  va_end(arg);
+  if (ret > 0) {
+    this->print(x, y, font, color, display::TextAlign::TOP_LEFT, buffer);
+  }
+}
+
+int ILI9881C::draw_cached_glyph_(int x, int y, display::BaseFont *font, Color color, Color background,
+                                 const char *glyph) {
+  GlyphKey key{font, 0, color.raw_32, background.raw_32};
+  memcpy(&key.codepoint, glyph, strlen(glyph));
+  
+  GlyphSlot *slot = this->glyph_cache_.find(key);
+  // Une zone de clipping tronquerait la capture : rendu direct, mis en cache plus tard
+  if (slot == nullptr && !this->get_clipping().is_set()) {
+    slot = this->capture_glyph_(key, font, color, background, glyph);
+  }
+  if (slot == nullptr || slot->direct) {
+    font->print(x, y, this, color, glyph, background);
+    int width, x_offset, baseline, height;
+    font->measure(glyph, &width, &x_offset, &baseline, &height);
+    return width + x_offset;
+  }
+  this->blit_glyph_(*slot, x, y);
+  return slot->advance;
+}
+
+GlyphSlot *ILI9881C::capture_glyph_(const GlyphKey &key, display::BaseFont *font, Color color, Color background,
+                                    const char *glyph) {
+  // La police trace le glyphe dans [x_offset, x_offset + width) x [0, height)
+  int width, x_offset, baseline, height;
+  font->measure(glyph, &width, &x_offset, &baseline, &height);
+  if (width < 0 || height < 0 || width * height > GLYPH_SLOT_MAX_PIXELS) {
+    return nullptr;
+  }
+  
+  GlyphSlot *slot = this->glyph_cache_.insert(key);
+  slot->x = x_offset;
+  slot->y = 0;
+  slot->width = width;
+  slot->height = height;
+  slot->advance = width + x_offset;
+  this->capture_pixels_ = this->glyph_cache_.pixels(slot);
+  this->capture_mask_ = this->glyph_cache_.mask(slot);
+  this->capture_x_ = x_offset;
+  this->capture_width_ = width;
+  this->capture_height_ = height;
+  memset(this->capture_mask_, 0, (size_t) width * height);
+  this->capture_overflow_ = false;
+  
+  // Les pixels de la police sont encodés dans l'emplacement au lieu du framebuffer
+  auto draw_pixel_fn = this->draw_pixel_fn_;
+  this->draw_pixel_fn_ = &ILI9881C::capture_pixel_;
+  font->print(0, 0, this, color, glyph, background);
+  this->draw_pixel_fn_ = draw_pixel_fn;
+  
+  // Un pixel hors de la boîte serait perdu à chaque recopie : le glyphe reste
+  // en cache, marqué pour le rendu direct, et n'est plus capturé
+  if (this->capture_overflow_) {
+    slot->direct = true;
+  }
+  return slot;
+}
+
+void ILI9881C::capture_pixel_(int x, int y, Color color) {
+  const int cx = x - this->capture_x_;
+  if ((unsigned) cx >= (unsigned) this->capture_width_ || (unsigned) y >= (unsigned) this->capture_height_) {
+    this->capture_overflow_ = true;
+    return;
+  }
+  // Sans tramage : le glyphe est recopié à des positions quelconques
+  const size_t i = (size_t) y * this->capture_width_ + cx;
+  this->pixel_encoder_(this->capture_pixels_ + i * this->get_bytes_per_pixel_(), cx, y, color);
+  this->capture_mask_[i] = 1;
+}
+
+void ILI9881C::blit_glyph_(const GlyphSlot &slot, int x, int y) {
+  const int gx = x + slot.x;
+  const int gy = y + slot.y;
+  int x1 = gx, y1 = gy, x2 = gx + slot.width, y2 = gy + slot.height;
+  if (!this->clip_logical_rect_(x1, y1, x2, y2)) {
+    return;
+  }
+  
+  const uint8_t bpp = this->get_bytes_per_pixel_();
+  const size_t stride = (size_t) this->get_buffer_width_() * bpp;
+  const uint8_t *pixels = this->glyph_cache_.pixels(&slot);
+  const uint8_t *mask = this->glyph_cache_.mask(&slot);
+  // Colonnes et lignes du glyphe visibles après clipping (x1/y1 incluent l'offset)
+  const int cx1 = x1 - this->offset_x_ - gx;
+  const int cy1 = y1 - this->offset_y_ - gy;
+  const int count = x2 - x1;
+  for (int row = 0; row < y2 - y1; row++) {
+    const size_t src = (size_t) (cy1 + row) * slot.width + cx1;
+    uint8_t *dst = this->buffer_ + (size_t) this->map_row_(y1 + row) * stride + x1 * bpp;
+    // Plages de pixels dessinés, recopiées d'un bloc
+    for (int i = 0; i < count;) {
+      if (mask[src + i] == 0) {
+        i++;
+        continue;
+      }
+      int end = i + 1;
+      while (end < count && mask[src + end] != 0) {
+        end++;
+      }
+      memcpy(dst + i * bpp, pixels + (src + i) * bpp, (end - i) * bpp);
+      i = end;
+    }
+  }
+  this->mark_dirty_(x1, y1, x2, y2);
+}
+
+void ILI9881C::select_pixel_writer_() {
+  const bool bgr = this->color_order_ == COLOR_ORDER_BGR;
+  this->pixel_writer_ = select_pixel_writer(this->pixel_format_, this->invert_colors_, bgr, this->dithering_);
+  this->pixel_encoder_ = select_pixel_writer(this->pixel_format_, this->invert_colors_, bgr, false);
+  
+  // En rotation au flush, le rendu se fait sans transformation dans le buffer logique
+  switch (this->rotate_on_flush_() ? ROTATION_0 : this->rotation_) {
+    case ROTATION_0: this->draw_pixel_fn_ = &ILI9881C::draw_pixel_<ROTATION_0>; break;
+    case ROTATION_90: this->draw_pixel_fn_ = &ILI9881C::draw_pixel_<ROTATION_90>; break;
+    case ROTATION_180: this->draw_pixel_fn_ = &ILI9881C::draw_pixel_<ROTATION_180>; break;
+    case ROTATION_270: this->draw_pixel_fn_ = &ILI9881C::draw_pixel_<ROTATION_270>; break;
+  }
+}
+
+void ILI9881C::loop() {
+  // Mise en route du panel, sans délai bloquant
+  if (this->init_state_ != INIT_STATE_READY && this->init_state_ != INIT_STATE_FAILED) {
+    this->advance_init_();
+    return;
+  }
+  this->poll_vsync_();
+  if (this->present_pending_) {
+    this->send_display_buffer_();
+  }
+}
+
+bool ILI9881C::setup_vsync_() {
+#if SOC_MIPI_DSI_SUPPORTED
+  if (this->vsync_present_) {
+    this->vsync_sem_ = xSemaphoreCreateBinary();
+    if (this->vsync_sem_ == nullptr) {
+      return false;
+    }
+  }
+  
+  // Le compteur de trames est toujours tenu à jour
+  esp_lcd_dpi_panel_event_callbacks_t callbacks = {};
+  callbacks.on_refresh_done = ILI9881C::on_refresh_done_;
+  esp_err_t ret = esp_lcd_dpi_panel_register_event_callbacks(this->dpi_panel_, &callbacks, this);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to register DPI event callbacks: %s", esp_err_to_name(ret));
+    if (this->vsync_sem_ != nullptr) {
+      vSemaphoreDelete(this->vsync_sem_);
+      this->vsync_sem_ = nullptr;
+    }
+    return false;
+  }
+  
+  if (this->vsync_divisor_ > 0) {
+    // Les updates sont cadencés par les vsync, relevées depuis loop()
+    this->stop_poller();
+    this->high_freq_.start();
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if SOC_MIPI_DSI_SUPPORTED
+bool IRAM_ATTR ILI9881C::on_refresh_done_(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata,
+                                          void *user_ctx) {
+  auto *self = static_cast<ILI9881C *>(user_ctx);
+  self->vsync_count_.fetch_add(1, std::memory_order_relaxed);
+  BaseType_t woken = pdFALSE;
+  if (self->vsync_sem_ != nullptr) {
+    xSemaphoreGiveFromISR(self->vsync_sem_, &woken);
+  }
+  return woken == pdTRUE;
+}
+#endif
+
+void ILI9881C::wait_for_vsync_() {
+  // Ignorer une vsync déjà passée : on attend le début du prochain blanking
+  xSemaphoreTake(this->vsync_sem_, 0);
+  const uint32_t start = micros();
+  // Deux périodes de rafraîchissement au plus, le present ne doit pas se bloquer
+  const uint32_t timeout_ms = 2000 / std::max(this->get_refresh_rate_(), 1.0f) + 1;
+  if (xSemaphoreTake(this->vsync_sem_, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+    ESP_LOGV(TAG, "No vsync within %u ms", (unsigned) timeout_ms);
+  }
+  this->last_vsync_wait_us_ = micros() - start;
+}
+
+void ILI9881C::poll_vsync_() {
+  const uint32_t vsync = this->vsync_count_.load(std::memory_order_relaxed);
+  if (vsync == this->last_vsync_seen_) {
+    return;
+  }
+  // Déclencheur on_vsync au plus une fois par passage dans loop()
+  this->last_vsync_seen_ = vsync;
+  this->vsync_callback_.call(vsync);
+  
+  if (this->vsync_divisor_ == 0 || !this->initialized_) {
+    return;
+  }
+  if (!this->vsync_updates_started_) {
+    this->vsync_updates_started_ = true;
+    this->last_update_vsync_ = vsync;
+    this->update();
+    return;
+  }
+  const uint32_t elapsed = vsync - this->last_update_vsync_;
+  if (elapsed < this->vsync_divisor_) {
+    return;
+  }
+  // Créneaux sautés depuis le dernier update
+  if (elapsed >= 2u * this->vsync_divisor_) {
+    this->dropped_frames_ += elapsed / this->vsync_divisor_ - 1;
+  }
+  this->last_update_vsync_ = vsync;
+  this->update();
+}
+
+float ILI9881C::get_refresh_rate_() const {
+  const uint32_t h_total = this->hsync_ + this->hbp_ + this->display_width_ + this->hfp_;
+  const uint32_t v_total = this->vsync_ + this->vbp_ + this->display_height_ + this->vfp_;
+  return this->dpi_clk_freq_mhz_ * 1e6f / (h_total * v_total);
+}
+
+LinkBudget ILI9881C::plan_link_() const {
+  const uint32_t h_total = this->hsync_ + this->hbp_ + this->display_width_ + this->hfp_;
+  const uint32_t v_total = this->vsync_ + this->vbp_ + this->display_height_ + this->vfp_;
+  uint8_t bits_per_pixel = 24;
+  switch (this->pixel_format_) {
+    case PIXEL_FORMAT_RGB565: bits_per_pixel = 16; break;
+    case PIXEL_FORMAT_RGB666: bits_per_pixel = 18; break;
+    case PIXEL_FORMAT_RGB888: bits_per_pixel = 24; break;
+  }
+  return plan_link(this->display_width_, h_total, v_total, bits_per_pixel, this->data_lanes_,
+                   this->lane_bit_rate_mbps_, this->dpi_clk_freq_mhz_);
+}
+
+void ILI9881C::dump_config() {
+  ESP_LOGCONFIG(TAG, "ILI9881C Display:");
+  ESP_LOGCONFIG(TAG, "  Physical Size: %dx%d", this->display_width_, this->display_height_);
+  ESP_LOGCONFIG(TAG, "  Effective Size: %dx%d", this->get_width_internal(), this->get_height_internal());
+  
+  int rotation_degrees = 0;
+  switch (this->rotation_) {
+    case ROTATION_0: rotation_degrees = 0; break;
+    case ROTATION_90: rotation_degrees = 90; break;
+    case ROTATION_180: rotation_degrees = 180; break;
+    case ROTATION_270: rotation_degrees = 270; break;
+  }
+  ESP_LOGCONFIG(TAG, "  Rotation: %d° (%s)", rotation_degrees, 
+    this->rotation_mode_ == ROTATION_MODE_FLUSH ? "at flush" : "at draw time");
+  
+  ESP_LOGCONFIG(TAG, "  Color Order: %s", this->color_order_ == COLOR_ORDER_RGB ? "RGB" : "BGR");
+  const char *pixel_format = "RGB888";
+  switch (this->pixel_format_) {
+    case PIXEL_FORMAT_RGB565: pixel_format = "RGB565"; break;
+    case PIXEL_FORMAT_RGB666: pixel_format = "RGB666"; break;
+    case PIXEL_FORMAT_RGB888: pixel_format = "RGB888"; break;
+  }
+  ESP_LOGCONFIG(TAG, "  Pixel Format: %s", pixel_format);
+  ESP_LOGCONFIG(TAG, "  Dithering: %s", YESNO(this->dithering_));
+  ESP_LOGCONFIG(TAG, "  Offset: (%d, %d)", this->offset_x_, this->offset_y_);
+  ESP_LOGCONFIG(TAG, "  Invert Colors: %s", YESNO(this->invert_colors_));
+  ESP_LOGCONFIG(TAG, "  Auto Clear: %s", YESNO(this->auto_clear_enabled_));
+  ESP_LOGCONFIG(TAG, "  Partial Updates: %s", YESNO(this->partial_updates_));
+  ESP_LOGCONFIG(TAG, "  Background Layer: %s", YESNO(this->background_ != nullptr));
+  ESP_LOGCONFIG(TAG, "  Overlay Layers: %u", this->num_overlays_);
+  ESP_LOGCONFIG(TAG, "  Glyph Cache: %u slots", this->glyph_cache_.enabled() ? this->glyph_cache_size_ : 0);
+  const char *memory = "auto";
+  switch (this->framebuffer_memory_) {
+    case FRAMEBUFFER_MEMORY_AUTO: memory = "auto"; break;
+    case FRAMEBUFFER_MEMORY_PSRAM: memory = "PSRAM"; break;
+    case FRAMEBUFFER_MEMORY_INTERNAL: memory = "internal"; break;
+  }
+  ESP_LOGCONFIG(TAG, "  Framebuffer Memory: %s", this->direct_framebuffer_ ? "driver" : memory);
+  ESP_LOGCONFIG(TAG, "  Async Present: %s", YESNO(this->present_task_handle_ != nullptr));
+  ESP_LOGCONFIG(TAG, "  Refresh Rate: %.1f Hz", this->get_refresh_rate_());
+  ESP_LOGCONFIG(TAG, "  VSync Present: %s", YESNO(this->vsync_present_));
+  if (this->vsync_divisor_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Update Every: %u refresh(es)", this->vsync_divisor_);
+  }
+  ESP_LOGCONFIG(TAG, "  Skip Unchanged Frames: %s", YESNO(this->skip_unchanged_));
+  if (this->skip_unchanged_ && this->max_idle_interval_ms_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Max Idle Interval: %u ms", (unsigned) this->max_idle_interval_ms_);
+  }
+  if (this->stats_interval_ms_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Frame Stats Interval: %u ms", (unsigned) this->stats_interval_ms_);
+  }
+  if (this->health_check_interval_ms_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Health Check Interval: %u ms", (unsigned) this->health_check_interval_ms_);
+    ESP_LOGCONFIG(TAG, "  Recoveries: %u", (unsigned) this->recovery_count_);
+  }
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Render Time", this->render_time_sensor_);
+  LOG_SENSOR("  ", "Clear Time", this->clear_time_sensor_);
+  LOG_SENSOR("  ", "Flush Time", this->flush_time_sensor_);
+  LOG_SENSOR("  ", "Wait Time", this->wait_time_sensor_);
+  LOG_SENSOR("  ", "FPS", this->fps_sensor_);
+  LOG_SENSOR("  ", "Bytes Per Frame", this->bytes_per_frame_sensor_);
+  LOG_SENSOR("  ", "Recoveries", this->recoveries_sensor_);
+  LOG_SENSOR("  ", "Recovery Time", this->recovery_time_sensor_);
+#endif
+  
+  ESP_LOGCONFIG(TAG, "  MIPI DSI Configuration:");
+  ESP_LOGCONFIG(TAG, "    Data Lanes: %d", this->data_lanes_);
+  ESP_LOGCONFIG(TAG, "    Lane Bit Rate: %d Mbps", this->lane_bit_rate_mbps_);
+  ESP_LOGCONFIG(TAG, "    DPI Clock: %d MHz", this->dpi_clk_freq_mhz_);
+  const LinkBudget budget = this->plan_link_();
+  ESP_LOGCONFIG(TAG, "    Link Usage: %.0f Mbps per lane (%.0f%%)", budget.required_mbps,
+                budget.utilization * 100.0f);
+  
+  ESP_LOGCONFIG(TAG, "  DPI Video Timings:");
+  ESP_LOGCONFIG(TAG, "    H: %d + %d + %d + %d = %d", 
+    this->hbp_, this->display_width_, this->hfp_, this->hsync_, 
+    this->hbp_ + this->display_width_ + this->hfp_ + this->hsync_);
+  ESP_LOGCONFIG(TAG, "    V: %d + %d + %d + %d = %d", 
+    this->vbp_, this->display_height_, this->vfp_, this->vsync_,
+    this->vbp_ + this->display_height_ + this->vfp_ + this->vsync_);
+  
+  if (this->external_flush_) {
+    ESP_LOGCONFIG(TAG, "  External Flush: YES (no render buffer)");
+  } else if (this->band_height_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Band Rendering: %u lines (2 x %u bytes)", this->band_height_,
+                  (unsigned) (this->get_buffer_width_() * this->band_height_ * this->get_bytes_per_pixel_()));
+  } else {
+    ESP_LOGCONFIG(TAG, "  Buffer Size: %.2f MB", this->get_buffer_length_internal_() / (1024.0 * 1024.0));
+  }
+  ESP_LOGCONFIG(TAG, "  Direct Frame Buffer: %s (%d buffer(s))", YESNO(this->direct_framebuffer_), 
+    this->direct_framebuffer_ ? this->num_framebuffers_ : 1);
+  ESP_LOGCONFIG(TAG, "  Init Sequence: %u bytes", (unsigned) this->init_sequence_length_);
+  
+  LOG_PIN("  Reset Pin: ", this->reset_pin_);
+  
+#if !SOC_MIPI_DSI_SUPPORTED
+  ESP_LOGE(TAG, "MIPI DSI not supported on this ESP32 variant");
+#endif
+  
+  if (Component::is_failed()) {
+    ESP_LOGE(TAG, "Failed to initialize display");
+  }
+}
+
+// Méthodes de configuration
+void ILI9881C::set_dimensions(uint16_t width, uint16_t height) {
+  this->display_width_ = width;
+  this->display_height_ = height;
+}
+
+void ILI9881C::set_offsets(uint16_t offset_x, uint16_t offset_y) {
+  this->offset_x_ = offset_x;
+  this->offset_y_ = offset_y;
+}
+
+void ILI9881C::set_rotation(Rotation rotation) {
+  this->rotation_ = rotation;
+  this->select_pixel_writer_();
 }
 
 int ILI9881C::get_width_internal() {
-  return this->display_width_;
+  // Largeur logique, après rotation
+  return rotation_swaps_axes(this->rotation_) ? this->display_height_ : this->display_width_;
 }
 
 int ILI9881C::get_height_internal() {
-  return this->display_height_;
+  return rotation_swaps_axes(this->rotation_) ? this->display_width_ : this->display_height_;
 }
 
 size_t ILI9881C::get_buffer_length_internal_() {
-  return this->display_width_ * this->display_height_ * 3; // RGB888
+  return this->display_width_ * this->display_height_ * this->get_bytes_per_pixel_();
 }
 
 }  // namespace ili9881c
@@ -1,41 +1,172 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/display/display_buffer.h"
 #include "esphome/core/gpio.h"
+#include "esphome/core/defines.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#include "blit.h"
+#include "frame_stats.h"
+#include "glyph_cache.h"
+#include "layer.h"
+#include "link_budget.h"
+#include "pixel_format.h"
+#include "rotation.h"
 
 #ifdef USE_ESP32
 
+#include "soc/soc_caps.h"
+
+#include <atomic>
+#include <functional>
 #include <vector>
 
 #if SOC_MIPI_DSI_SUPPORTED
 #include "esp_lcd_mipi_dsi.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
+#include "esp_cache.h"
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#if SOC_PPA_SUPPORTED
+#include "driver/ppa.h"
 #endif
 
 namespace esphome {
 namespace ili9881c {
 
-enum Rotation : uint8_t {
-  ROTATION_0 = 0,
-  ROTATION_90 = 1,
-  ROTATION_180 = 2,
-  ROTATION_270 = 3,
-};
-
 enum ColorOrder : uint8_t {
   COLOR_ORDER_RGB = 0,
   COLOR_ORDER_BGR = 1,
 };
 
-struct InitCommand {
-  uint8_t cmd;
-  std::vector<uint8_t> data;
-  uint16_t delay_ms;
-  bool is_delay;
+// Mémoire du buffer de rendu ; en rendu direct, les framebuffers appartiennent au driver DPI
+enum FramebufferMemory : uint8_t {
+  FRAMEBUFFER_MEMORY_AUTO = 0,
+  FRAMEBUFFER_MEMORY_PSRAM = 1,
+  FRAMEBUFFER_MEMORY_INTERNAL = 2,
 };
 
+// Nombre maximal de rectangles modifiés suivis entre deux flushs
+static const uint8_t MAX_DIRTY_RECTS = 8;
+// Écart (en pixels) en dessous duquel deux zones modifiées sont fusionnées
+static const uint16_t DIRTY_MERGE_GAP = 16;
+
+// Hauteur (en lignes) des bandes dont l'empreinte détecte les trames inchangées
+static const uint16_t HASH_BAND_ROWS = 16;
+
+// Surface (pixels) à partir de laquelle un remplissage uniforme passe par le PPA
+static const uint32_t PPA_FILL_MIN_PIXELS = 64 * 1024;
+
+// Surface (pixels) à partir de laquelle un calque est composé par le PPA
+static const uint32_t PPA_BLEND_MIN_PIXELS = 16 * 1024;
+
+// Nombre maximal de buffers de rendu (framebuffers DPI en mode direct)
+static const uint8_t MAX_FRAMEBUFFERS = 3;
+
+// Zone modifiée, en coordonnées du buffer de rendu (x2/y2 exclus)
+struct DirtyRect {
+  uint16_t x1;
+  uint16_t y1;
+  uint16_t x2;
+  uint16_t y2;
+};
+
+// Nombre maximal de calques superposés au rendu principal
+static const uint8_t MAX_OVERLAY_LAYERS = 4;
+// Cibles de select_layer() autres que les calques superposés (0..MAX_OVERLAY_LAYERS-1)
+static const int8_t LAYER_MAIN = -1;
+static const int8_t LAYER_BACKGROUND = -2;
+// Alignement des buffers de rendu et de calques : ligne de cache, exigée par le PPA
+static const size_t BUFFER_ALIGN = 64;
+
+// Calque superposé, conservé d'une trame à l'autre et composé sur la trame après le rendu
+struct OverlayLayer {
+  uint8_t *buffer{nullptr};
+  uint8_t alpha{255};
+  bool visible{true};
+  bool use_color_key{false};
+  // Couleur clé (0xRRGGBB) et son encodage au format natif
+  uint32_t color_key{0};
+  uint8_t key[3]{};
+  // Zone contenant des pixels dessinés depuis le dernier clear_layer()
+  DirtyRect bounds{};
+  bool has_content{false};
+};
+
+// Trame à présenter : buffer de rendu et zones modifiées figées au moment du present
+struct FrameJob {
+  uint8_t *buffer;
+  DirtyRect rects[MAX_DIRTY_RECTS];
+  uint8_t count;
+  // Décalage de la zone de défilement au moment du present
+  uint16_t scroll_offset;
+};
+
+// Zone confiée par flush_area() à la tâche de transfert des zones
+using flush_area_callback_t = std::function<void()>;
+struct FlushArea {
+  // Rectangle logique, borne haute exclue, offsets appliqués et clippé
+  int x1, y1, x2, y2;
+  const uint8_t *pixels;
+  size_t stride;
+  BlitFormat format;
+  bool big_endian;
+  flush_area_callback_t done;
+};
+
+// Zones en vol : une en transfert pendant que la bibliothèque remplit l'autre buffer
+static const uint8_t FLUSH_AREA_SLOTS = 2;
+
+// Durées (µs) d'une passe de rendu par bandes, cumulées sur toutes les bandes
+struct BandPassTimes {
+  uint32_t clear_us;
+  uint32_t render_us;
+  uint32_t flush_us;
+};
+
+// Étapes de la mise en route du panel, avancées depuis loop()
+enum InitState : uint8_t {
+  INIT_STATE_IDLE = 0,
+  INIT_STATE_RESET,
+  INIT_STATE_RESET_RELEASE,
+  INIT_STATE_COMMANDS,
+  INIT_STATE_PANEL_ON,
+  INIT_STATE_READY,
+  INIT_STATE_FAILED,
+};
+
+// Flux d'init : [len][cmd][data...] par commande, [INIT_DELAY_RECORD][lo][hi] par délai (ms)
+static const uint8_t INIT_DELAY_RECORD = 0xFF;
+
+// Lectures DCS du contrôle de santé
+static const uint8_t DCS_GET_POWER_MODE = 0x0A;
+static const uint8_t DCS_GET_DISPLAY_STATUS = 0x09;
+static const uint8_t DCS_GET_SIGNAL_MODE = 0x0E;
+// Bits de DCS_GET_POWER_MODE attendus d'un panel actif : sortie de veille, affichage allumé
+static const uint8_t POWER_MODE_READY = 0x14;
+// Contrôles de santé consécutifs en échec avant la réinitialisation du panel
+static const uint8_t HEALTH_CHECK_MAX_FAILURES = 2;
+
+// État du panel relu par DCS, comparé à celui relevé à la mise en route
+struct PanelStatus {
+  uint8_t power_mode;
+  uint8_t display_status[4];
+  uint8_t signal_mode;
+};
+
+class ILI9881C;
+using ili9881c_writer_t = std::function<void(ILI9881C &)>;
+
 class ILI9881C : public display::DisplayBuffer {
  public:
   void setup() override;
@@ -47,10 +178,96 @@ class ILI9881C : public display::DisplayBuffer {
   void set_reset_pin(GPIOPin *reset_pin) { this->reset_pin_ = reset_pin; }
   void set_dimensions(uint16_t width, uint16_t height);
   void set_offsets(uint16_t offset_x, uint16_t offset_y);
-  void set_invert_colors(bool invert) { this->invert_colors_ = invert; }
+  void set_invert_colors(bool invert) {
+    this->invert_colors_ = invert;
+    this->select_pixel_writer_();
+  }
   void set_auto_clear_enabled(bool enable) { this->auto_clear_enabled_ = enable; }
   void set_rotation(Rotation rotation);
-  void set_color_order(ColorOrder color_order) { this->color_order_ = color_order; }
+  void set_rotation_mode(RotationMode mode) {
+    this->rotation_mode_ = mode;
+    this->select_pixel_writer_();
+  }
+  void set_color_order(ColorOrder color_order) {
+    this->color_order_ = color_order;
+    this->select_pixel_writer_();
+  }
+  void set_partial_updates(bool partial_updates) { this->partial_updates_ = partial_updates; }
+  void set_pixel_format(PixelFormat pixel_format) {
+    this->pixel_format_ = pixel_format;
+    this->select_pixel_writer_();
+  }
+  void set_dithering(bool dithering) {
+    this->dithering_ = dithering;
+    this->select_pixel_writer_();
+  }
+  void set_direct_framebuffer(bool direct) { this->direct_framebuffer_ = direct; }
+  void set_num_framebuffers(uint8_t num) { this->num_framebuffers_ = num; }
+  void set_framebuffer_memory(FramebufferMemory memory) { this->framebuffer_memory_ = memory; }
+  void set_async_present(bool async_present) { this->async_present_ = async_present; }
+  void set_stats_interval(uint32_t interval_ms) { this->stats_interval_ms_ = interval_ms; }
+  void set_benchmark(bool benchmark) { this->benchmark_ = benchmark; }
+  // Présentation calée sur la fin de rafraîchissement du panel
+  void set_vsync_present(bool vsync_present) { this->vsync_present_ = vsync_present; }
+  // update() appelé toutes les N trames du panel au lieu de update_interval (0 : désactivé)
+  void set_vsync_divisor(uint8_t divisor) { this->vsync_divisor_ = divisor; }
+  // Saut des presents dont le contenu n'a pas changé, et ralentissement
+  // des updates jusqu'à max_idle_interval tant que l'écran reste statique
+  void set_skip_unchanged(bool skip_unchanged) { this->skip_unchanged_ = skip_unchanged; }
+  void set_max_idle_interval(uint32_t interval_ms) { this->max_idle_interval_ms_ = interval_ms; }
+  // Rétablit immédiatement l'intervalle d'update nominal
+  void request_redraw();
+  
+  // Calques : fond conservé, recopié à la place de l'effacement, et calques
+  // superposés composés sur la trame avec une opacité globale et/ou une couleur clé
+  void set_background_layer(bool background_layer) { this->background_layer_ = background_layer; }
+  void add_overlay_layer(uint8_t alpha, bool use_color_key, uint32_t color_key);
+  // Redirige le dessin vers LAYER_BACKGROUND, un calque superposé ou LAYER_MAIN
+  bool select_layer(int8_t layer);
+  void clear_layer(uint8_t index);
+  void set_layer_alpha(uint8_t index, uint8_t alpha);
+  void set_layer_visible(uint8_t index, bool visible);
+  
+  // Zone de défilement : lignes [top, top + height) du buffer de rendu gérées comme
+  // un anneau. scroll(n) décale le contenu de n lignes vers le haut (n < 0 : vers le bas)
+  // sans le recopier ; seules les lignes découvertes, effacées, restent à dessiner.
+  // height = 0 désactive la zone.
+  bool set_scroll_region(uint16_t top, uint16_t height);
+  void scroll(int lines);
+  uint16_t get_scroll_offset() const { return this->scroll_offset_; }
+  
+  // Texte : chaque glyphe est rendu une fois par la police dans un cache LRU au format
+  // natif (police, caractère, couleurs), puis recopié par lignes. 0 emplacement : désactivé
+  void set_glyph_cache_size(uint16_t slots) { this->glyph_cache_size_ = slots; }
+  // Rendu par bandes de N lignes (0 : buffer de rendu complet). Le writer est rejoué
+  // pour chaque bande, dessinée dans l'un de deux petits buffers en SRAM interne
+  void set_band_height(uint16_t lines) { this->band_height_ = lines; }
+  // Une bibliothèque graphique écrit elle-même dans le framebuffer DPI via flush_area() :
+  // pas de buffer de rendu, update() ne dessine ni ne présente rien
+  void set_external_flush(bool external_flush) { this->external_flush_ = external_flush; }
+  void clear_glyph_cache() { this->glyph_cache_.clear(); }
+  uint32_t get_glyph_cache_hits() const { return this->glyph_cache_.hits(); }
+  uint32_t get_glyph_cache_misses() const { return this->glyph_cache_.misses(); }
+  // Contrôle périodique du panel par lectures DCS (0 : désactivé). Un panel qui ne
+  // répond plus comme à la mise en route (ESD, baisse d'alimentation) est réinitialisé
+  void set_health_check_interval(uint32_t interval_ms) { this->health_check_interval_ms_ = interval_ms; }
+  // Reset et séquence d'init du panel seuls : bus DSI, panel DPI et framebuffers sont conservés
+  void recover();
+  uint32_t get_recovery_count() const { return this->recovery_count_; }
+  uint32_t get_last_recovery_ms() const { return this->last_recovery_ms_; }
+  void add_on_vsync_callback(std::function<void(uint32_t)> &&callback) {
+    this->vsync_callback_.add(std::move(callback));
+  }
+#ifdef USE_SENSOR
+  void set_render_time_sensor(sensor::Sensor *sensor) { this->render_time_sensor_ = sensor; }
+  void set_clear_time_sensor(sensor::Sensor *sensor) { this->clear_time_sensor_ = sensor; }
+  void set_flush_time_sensor(sensor::Sensor *sensor) { this->flush_time_sensor_ = sensor; }
+  void set_wait_time_sensor(sensor::Sensor *sensor) { this->wait_time_sensor_ = sensor; }
+  void set_fps_sensor(sensor::Sensor *sensor) { this->fps_sensor_ = sensor; }
+  void set_bytes_per_frame_sensor(sensor::Sensor *sensor) { this->bytes_per_frame_sensor_ = sensor; }
+  void set_recoveries_sensor(sensor::Sensor *sensor) { this->recoveries_sensor_ = sensor; }
+  void set_recovery_time_sensor(sensor::Sensor *sensor) { this->recovery_time_sensor_ = sensor; }
+#endif
   
   void set_data_lanes(uint8_t lanes) { this->data_lanes_ = lanes; }
   void set_lane_bit_rate_mbps(uint16_t rate) { this->lane_bit_rate_mbps_ = rate; }
@@ -64,15 +281,69 @@ class ILI9881C : public display::DisplayBuffer {
   void set_vfp(uint16_t vfp) { this->vfp_ = vfp; }
   
   void set_rotation(int rotation) { 
-    this->set_rotation(static_cast<Rotation>(rotation)); 
+    // Accepte aussi les degrés (display::DisplayRotation)
+    this->set_rotation(static_cast<Rotation>(rotation >= 4 ? (rotation / 90) & 3 : rotation)); 
   }
   
-  void clear_init_sequence();
-  void add_init_command(uint8_t cmd, const std::vector<uint8_t> &data);
-  void add_init_delay(uint16_t delay_ms);
+  // Séquence générée par __init__.py, lue en place (flash) au démarrage
+  void set_init_sequence(const uint8_t *sequence, size_t length) {
+    this->init_sequence_ = sequence;
+    this->init_sequence_length_ = length;
+  }
 
   int get_width_internal() override;
   int get_height_internal() override;
+
+  void fill(Color color) override;
+  
+  // Chemins rapides par plages : masquent les versions pixel par pixel de Display
+  // lorsqu'ils sont appelés depuis la lambda (it est un ILI9881C &)
+  void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON);
+  void horizontal_line(int x, int y, int width, Color color = COLOR_ON);
+  void vertical_line(int x, int y, int height, Color color = COLOR_ON);
+  
+  // Copie d'un bloc de pixels avec conversion vers le format du framebuffer.
+  // src_stride : octets par ligne source ; big_endian : voir decode_pixel()
+  void blit(int x, int y, int w, int h, const uint8_t *src, size_t src_stride, BlitFormat format,
+            bool big_endian = false);
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+  
+  // Callback de flush des bibliothèques graphiques à buffers partiels (LVGL...) : la zone
+  // [x1, x2] x [y1, y2] (bornes incluses, coordonnées logiques) est convertie et tournée
+  // directement dans le framebuffer du driver DPI. Nécessite external_flush. Le transfert
+  // se fait dans une tâche dédiée, l'appel attend qu'un emplacement se libère ; done est
+  // appelé depuis cette tâche une fois pixels relu (aussitôt pour une zone hors écran),
+  // le buffer peut alors être réutilisé. Retourne false si la zone n'a pas pu être prise
+  // en charge (done n'est alors pas appelé).
+  bool flush_area(int x1, int y1, int x2, int y2, const uint8_t *pixels, flush_area_callback_t &&done = nullptr,
+                  BlitFormat format = BLIT_FORMAT_RGB565, bool big_endian = false);
+  
+  // Texte via le cache de glyphes ; les autres surcharges restent celles de Display
+  using display::Display::print;
+  using display::Display::printf;
+  void print(int x, int y, display::BaseFont *font, Color color, display::TextAlign align, const char *text,
+             Color background = COLOR_OFF);
+  void print(int x, int y, display::BaseFont *font, Color color, const char *text, Color background = COLOR_OFF);
+  void printf(int x, int y, display::BaseFont *font, Color color, display::TextAlign align, const char *format, ...)
+      __attribute__((format(printf, 7, 8)));
+  void printf(int x, int y, display::BaseFont *font, Color color, const char *format, ...)
+      __attribute__((format(printf, 6, 7)));
+  
+  void set_writer(ili9881c_writer_t &&writer) {
+    display::Display::set_writer([this, writer](display::Display &) { writer(*this); });
+  }
+
+  // Octets envoyés au panel lors du dernier flush
+  uint32_t get_bytes_flushed() const { return this->bytes_flushed_; }
+  // Presents reportés car la trame précédente était encore en cours de transfert
+  uint32_t get_frames_deferred() const { return this->frames_deferred_; }
+  // Nombre de rafraîchissements du panel depuis le démarrage
+  uint32_t get_vsync_count() const { return this->vsync_count_.load(std::memory_order_relaxed); }
+  // Créneaux de vsync_divisor manqués (rendu ou transfert trop long)
+  uint32_t get_dropped_frames() const { return this->dropped_frames_; }
+  // Presents évités car le contenu était identique
+  uint32_t get_frames_unchanged() const { return this->frames_unchanged_; }
   
   display::DisplayType get_display_type() override { 
     return display::DisplayType::DISPLAY_TYPE_COLOR; 
@@ -82,11 +353,122 @@ class ILI9881C : public display::DisplayBuffer {
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
   
   bool init_display_();
-  void setup_default_init_sequence_();
+  void advance_init_();
+  void init_wait_(uint32_t delay_ms);
+  void init_failed_();
+  bool finish_setup_();
+  void finish_recovery_();
+  
+  // Contrôle de santé
+  bool read_dcs_(uint8_t cmd, uint8_t *data, size_t len);
+  bool read_panel_status_(PanelStatus &status);
+  void check_health_();
   void setup_mipi_dsi_();
   void setup_dpi_config_();
   void send_display_buffer_();
   size_t get_buffer_length_internal_();
+  uint8_t get_bytes_per_pixel_() const { return bytes_per_pixel(this->pixel_format_); }
+  void select_pixel_writer_();
+  template<Rotation ROT> void draw_pixel_(int x, int y, Color color);
+  
+  // Géométrie : le buffer de rendu est logique si la rotation est faite au flush
+  bool rotate_on_flush_() const {
+    return this->rotation_mode_ == ROTATION_MODE_FLUSH && this->rotation_ != ROTATION_0;
+  }
+  int get_buffer_width_() const {
+    return this->rotate_on_flush_() && rotation_swaps_axes(this->rotation_) ? this->display_height_ : this->display_width_;
+  }
+  int get_buffer_height_() const {
+    return this->rotate_on_flush_() && rotation_swaps_axes(this->rotation_) ? this->display_width_ : this->display_height_;
+  }
+  bool clip_logical_rect_(int &x1, int &y1, int &x2, int &y2);
+  bool clip_rect_(int &x1, int &y1, int &x2, int &y2);
+  void fill_rect_(int x1, int y1, int x2, int y2, Color color);
+  bool fill_rect_ppa_(int x1, int y1, int x2, int y2, const uint8_t *pixel);
+  void clear_drawn_regions_();
+  void add_drawn_rect_(uint8_t index, const DirtyRect &rect);
+  
+  // Calques (layer.h pour les noyaux de composition)
+  void setup_layers_();
+  void restore_background_(const DirtyRect &rect);
+  void compose_layers_();
+  bool compose_layer_ppa_(const OverlayLayer &layer, const DirtyRect &rect);
+  
+  // Zone de défilement : ligne mémoire d'une ligne du buffer, et fin de la plage
+  // de lignes [y, y2) contiguë en mémoire à partir de y
+  int map_row_(int y, uint16_t offset) const {
+    const uint32_t row = y - this->scroll_top_;
+    if (row >= this->scroll_height_) {
+      return y - this->band_top_;
+    }
+    const uint32_t shifted = row + offset;
+    return this->scroll_top_ + (shifted >= this->scroll_height_ ? shifted - this->scroll_height_ : shifted);
+  }
+  int map_row_(int y) const { return this->map_row_(y, this->scroll_offset_); }
+  int row_run_end_(int y, int y2, uint16_t offset) const;
+  void unroll_scroll_region_();
+  
+  // Cache de glyphes : capture du rendu de la police à la place des écritures de pixels
+  int draw_cached_glyph_(int x, int y, display::BaseFont *font, Color color, Color background, const char *glyph);
+  GlyphSlot *capture_glyph_(const GlyphKey &key, display::BaseFont *font, Color color, Color background,
+                            const char *glyph);
+  void capture_pixel_(int x, int y, Color color);
+  void blit_glyph_(const GlyphSlot &slot, int x, int y);
+
+  // Suivi des zones modifiées
+  void mark_dirty_(int x1, int y1, int x2, int y2);
+  void merge_dirty_rect_(uint8_t index);
+  uint8_t build_flush_bands_(const DirtyRect *rects, uint8_t count, DirtyRect *bands);
+  void flush_dirty_rects_(const FrameJob &job);
+  
+  // Present : synchrone, ou confié à la tâche de flush
+  void present_frame_(const FrameJob &job);
+  void record_flush_();
+  void log_frame_stats_();
+  
+  // Détection des trames inchangées
+  bool filter_unchanged_bands_();
+  void back_off_update_();
+  
+  // Synchronisation sur le rafraîchissement du panel
+  bool setup_vsync_();
+  void wait_for_vsync_();
+  void poll_vsync_();
+  float get_refresh_rate_() const;
+  // Budget de la liaison DSI pour les timings, lanes et format courants
+  LinkBudget plan_link_() const;
+#if SOC_MIPI_DSI_SUPPORTED
+  static bool on_refresh_done_(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx);
+#endif
+  
+  // Rendu par bandes : draw est rejoué pour chaque bande de band_height lignes
+  void update_bands_();
+  BandPassTimes render_bands_(uint16_t band_height, const std::function<void()> &draw);
+  void set_band_(int top, int rows);
+  
+  // Mesure des chemins de rendu au démarrage (benchmark.cpp)
+  void run_benchmark_();
+  void run_band_benchmark_();
+  bool setup_present_task_();
+  static void present_task_(void *arg);
+  
+  // Zones de flush_area() : tâche de transfert et écriture dans le framebuffer DPI
+  bool setup_area_task_();
+  static void area_task_(void *arg);
+  void write_area_(const FlushArea &area);
+  
+  // Framebuffers
+  bool setup_framebuffers_();
+  uint8_t *allocate_render_buffer_(size_t length);
+  // Remplit length octets avec la couleur de fond encodée
+  void fill_off_(uint8_t *buffer, size_t length);
+  // Write-back du cache limité à une zone (base : début du buffer, stride : octets par ligne)
+  void sync_rect_(uint8_t *base, size_t stride, int x1, int y1, int x2, int y2);
+  void swap_framebuffers_(const DirtyRect *bands, uint8_t count);
+  
+  // Rotation au flush
+  bool setup_flush_rotation_();
+  void flush_rotated_(const FrameJob &job);
   
   GPIOPin *dc_pin_{nullptr};
   GPIOPin *reset_pin_{nullptr};
@@ -98,7 +480,15 @@ class ILI9881C : public display::DisplayBuffer {
   bool invert_colors_{false};
   bool auto_clear_enabled_{true};
   Rotation rotation_{ROTATION_0};
+  RotationMode rotation_mode_{ROTATION_MODE_DRAW};
   ColorOrder color_order_{COLOR_ORDER_RGB};
+  PixelFormat pixel_format_{PIXEL_FORMAT_RGB888};
+  bool dithering_{false};
+  // Écriture spécialisée choisie selon format/inversion/ordre (avec et sans tramage)
+  PixelWriteFn pixel_writer_{&write_pixel<PIXEL_FORMAT_RGB888, false, false, false>};
+  PixelWriteFn pixel_encoder_{&write_pixel<PIXEL_FORMAT_RGB888, false, false, false>};
+  // Écriture d'un pixel logique, spécialisée selon la rotation
+  void (ILI9881C::*draw_pixel_fn_)(int, int, Color){&ILI9881C::draw_pixel_<ROTATION_0>};
   
   uint8_t data_lanes_{2};
   uint16_t lane_bit_rate_mbps_{1000};
@@ -111,16 +501,174 @@ class ILI9881C : public display::DisplayBuffer {
   uint16_t vbp_{16};
   uint16_t vfp_{16};
   
-  std::vector<InitCommand> init_commands_;
+  const uint8_t *init_sequence_{nullptr};
+  size_t init_sequence_length_{0};
+
+  bool partial_updates_{true};
+  DirtyRect dirty_rects_[MAX_DIRTY_RECTS];
+  uint8_t dirty_count_{0};
+  uint8_t last_dirty_{0};
+  uint32_t bytes_flushed_{0};
+  
+  bool direct_framebuffer_{false};
+  uint8_t num_framebuffers_{1};
+  FramebufferMemory framebuffer_memory_{FRAMEBUFFER_MEMORY_AUTO};
+  uint8_t *framebuffers_[MAX_FRAMEBUFFERS]{};
+  uint8_t back_buffer_{0};
+  // Bandes envoyées lors des dernières trames, à recopier dans le nouveau back buffer
+  DirtyRect history_[MAX_FRAMEBUFFERS - 1][MAX_DIRTY_RECTS];
+  uint8_t history_count_[MAX_FRAMEBUFFERS - 1]{};
+  // Zones dessinées lors de la dernière trame rendue dans chaque buffer (auto-clear)
+  DirtyRect drawn_rects_[MAX_FRAMEBUFFERS][MAX_DIRTY_RECTS];
+  uint8_t drawn_count_[MAX_FRAMEBUFFERS]{};
+  
+  // Calques ; buffer_ pointe sur le calque sélectionné, main_buffer_ garde alors le buffer de rendu
+  bool background_layer_{false};
+  uint8_t *background_{nullptr};
+  DirtyRect background_bounds_{};
+  bool background_drawn_{false};
+  OverlayLayer overlays_[MAX_OVERLAY_LAYERS];
+  uint8_t num_overlays_{0};
+  int8_t active_layer_{LAYER_MAIN};
+  uint8_t *main_buffer_{nullptr};
+  
+  // Rendu par bandes : buffer_ pointe sur l'un des deux buffers de bande, qui
+  // contient les lignes [band_top_, band_top_ + band_rows_) du panel ;
+  // band_clip_ est la même bande en coordonnées logiques
+  uint16_t band_height_{0};
+  bool external_flush_{false};
+  uint8_t *band_buffers_[2]{};
+  uint8_t band_index_{0};
+  int band_top_{0};
+  int band_rows_{0};
+  DirtyRect band_clip_{};
+  
+  // Zone de défilement (scroll_height_ = 0 : désactivée) ; la ligne y de la zone est
+  // stockée à la ligne scroll_top_ + (y - scroll_top_ + scroll_offset_) % scroll_height_
+  uint16_t scroll_top_{0};
+  uint16_t scroll_height_{0};
+  uint16_t scroll_offset_{0};
+  
+  uint16_t glyph_cache_size_{0};
+  GlyphCache glyph_cache_;
+  // Emplacement en cours de capture ; capture_x_ : abscisse de sa première colonne
+  uint8_t *capture_pixels_{nullptr};
+  uint8_t *capture_mask_{nullptr};
+  int capture_x_{0};
+  int capture_width_{0};
+  int capture_height_{0};
+  bool capture_overflow_{false};
+  
+  // Present asynchrone : la tâche de flush consomme les trames de present_queue_
+  // et rend present_done_ à la fin de chaque transfert
+  bool async_present_{false};
+  TaskHandle_t present_task_handle_{nullptr};
+  QueueHandle_t present_queue_{nullptr};
+  SemaphoreHandle_t present_done_{nullptr};
+  
+  // flush_area() : area_queue_ transmet à la tâche les indices des emplacements remplis,
+  // area_free_ rend les emplacements libres (contre-pression sur la bibliothèque)
+  TaskHandle_t area_task_handle_{nullptr};
+  QueueHandle_t area_queue_{nullptr};
+  QueueHandle_t area_free_{nullptr};
+  FlushArea area_slots_[FLUSH_AREA_SLOTS];
+  bool area_task_failed_{false};
+  // Lignes converties au format natif avant le transposé (tâche des zones uniquement)
+  std::vector<uint8_t> area_tile_;
+  uint32_t frames_deferred_{0};
+  
+  // Mesures par trame (µs) ; la durée du flush est écrite par la tâche de
+  // flush et relevée par la boucle principale une fois la trame terminée
+  FrameStat render_stat_;
+  FrameStat clear_stat_;
+  FrameStat flush_stat_;
+  FrameStat wait_stat_;
+  FrameStat bytes_stat_;
+  volatile uint32_t last_flush_us_{0};
+  volatile uint32_t last_vsync_wait_us_{0};
+  uint32_t present_wait_us_{0};
+  // Present reporté faute de trame libre, et instant du premier report
+  bool present_pending_{false};
+  uint32_t present_deferred_us_{0};
+  volatile bool flush_pending_{false};
+  uint32_t frames_presented_{0};
+  uint32_t stats_interval_ms_{60000};
+  uint32_t stats_last_ms_{0};
+  bool benchmark_{false};
+  
+  // VSync : compteur incrémenté par l'ISR de fin de rafraîchissement, qui
+  // libère aussi vsync_sem_ pour le present en attente
+  bool vsync_present_{false};
+  uint8_t vsync_divisor_{0};
+  std::atomic<uint32_t> vsync_count_{0};
+  SemaphoreHandle_t vsync_sem_{nullptr};
+  uint32_t last_vsync_seen_{0};
+  uint32_t last_update_vsync_{0};
+  bool vsync_updates_started_{false};
+  uint32_t dropped_frames_{0};
+  CallbackManager<void(uint32_t)> vsync_callback_;
+  HighFrequencyLoopRequester high_freq_;
+  
+  // Empreinte par bande de HASH_BAND_ROWS lignes de la dernière trame présentée
+  bool skip_unchanged_{false};
+  uint32_t max_idle_interval_ms_{0};
+  std::vector<uint32_t> band_hashes_;
+  std::vector<uint8_t> band_changed_;
+  bool hashes_valid_{false};
+  uint32_t frames_unchanged_{0};
+  // Ticks d'update à sauter (intervalle effectif = (idle_skip_ + 1) x update_interval)
+  uint32_t idle_skip_{0};
+  uint32_t idle_skip_remaining_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *render_time_sensor_{nullptr};
+  sensor::Sensor *clear_time_sensor_{nullptr};
+  sensor::Sensor *flush_time_sensor_{nullptr};
+  sensor::Sensor *wait_time_sensor_{nullptr};
+  sensor::Sensor *fps_sensor_{nullptr};
+  sensor::Sensor *bytes_per_frame_sensor_{nullptr};
+  sensor::Sensor *recoveries_sensor_{nullptr};
+  sensor::Sensor *recovery_time_sensor_{nullptr};
+#endif
+  
+  // Ligne temporaire des blits avec rotation
+  std::vector<uint8_t> line_buffer_;
+  
+  // Framebuffer du driver DPI, cible du transposé en rotation au flush
+  uint8_t *panel_fb_{nullptr};
+#if SOC_PPA_SUPPORTED
+  ppa_client_handle_t ppa_srm_{nullptr};
+  ppa_client_handle_t ppa_fill_{nullptr};
+  ppa_client_handle_t ppa_blend_{nullptr};
+#endif
   
 #if SOC_MIPI_DSI_SUPPORTED
   esp_lcd_dsi_bus_handle_t dsi_bus_{nullptr};
   esp_lcd_panel_io_handle_t io_handle_{nullptr};
   esp_lcd_panel_handle_t dpi_panel_{nullptr};
-  esp_lcd_dpi_panel_config_t *dpi_config_{nullptr};
 #endif
   
   bool initialized_{false};
+  InitState init_state_{INIT_STATE_IDLE};
+  size_t init_index_{0};
+  uint32_t init_wait_until_{0};
+  uint32_t setup_start_ms_{0};
+  
+  // Contrôle de santé et réinitialisation à chaud (machine d'init rejouée)
+  uint32_t health_check_interval_ms_{0};
+  PanelStatus panel_baseline_{};
+  uint8_t health_failures_{0};
+  bool recovering_{false};
+  uint32_t recovery_start_ms_{0};
+  uint32_t recovery_count_{0};
+  uint32_t last_recovery_ms_{0};
+  bool first_frame_presented_{false};
+};
+
+class VSyncTrigger : public Trigger<uint32_t> {
+ public:
+  explicit VSyncTrigger(ILI9881C *parent) {
+    parent->add_on_vsync_callback([this](uint32_t frame) { this->trigger(frame); });
+  }
 };
 
 }  // namespace ili9881c
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace ili9881c {
+
+// Mélange d'un pixel RGB565 natif : les trois composantes sont écartées dans
+// un mot de 32 bits (G en haut, R et B en bas) et mélangées en une multiplication.
+// alpha5 : 0..32
+inline uint16_t blend_rgb565(uint16_t fg, uint16_t bg, uint32_t alpha5) {
+  uint32_t f = (fg | ((uint32_t) fg << 16)) & 0x07E0F81F;
+  uint32_t b = (bg | ((uint32_t) bg << 16)) & 0x07E0F81F;
+  uint32_t v = ((((f - b) * alpha5) >> 5) + b) & 0x07E0F81F;
+  return v | (v >> 16);
+}
+
+// Mélange de quatre octets (composantes indépendantes) par mot de 32 bits,
+// deux voies de 16 bits à la fois. alpha : 0..256
+inline uint32_t blend_bytes4(uint32_t fg, uint32_t bg, uint32_t alpha) {
+  uint32_t rb = ((fg & 0x00FF00FF) * alpha + (bg & 0x00FF00FF) * (256 - alpha)) >> 8;
+  uint32_t ag = ((fg >> 8) & 0x00FF00FF) * alpha + ((bg >> 8) & 0x00FF00FF) * (256 - alpha);
+  return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+inline uint8_t blend_byte(uint8_t fg, uint8_t bg, uint32_t alpha) {
+  return (fg * alpha + bg * (256 - alpha)) >> 8;
+}
+
+// Compose count pixels d'un calque sur la trame, au format natif du framebuffer.
+// alpha : opacité globale du calque ; key : pixels transparents (nullptr : aucun)
+inline void compose_row(const uint8_t *src, uint8_t *dst, int count, uint8_t bpp, uint8_t alpha, const uint8_t *key) {
+  if (key == nullptr && alpha == 255) {
+    memcpy(dst, src, (size_t) count * bpp);
+    return;
+  }
+
+  const uint32_t a = alpha + (alpha >> 7);
+  if (bpp == 2) {
+    const uint16_t key_value = key != nullptr ? key[0] | (key[1] << 8) : 0;
+    for (int i = 0; i < count; i++, src += 2, dst += 2) {
+      uint16_t fg = src[0] | (src[1] << 8);
+      if (key != nullptr && fg == key_value) {
+        continue;
+      }
+      uint16_t v = alpha == 255 ? fg : blend_rgb565(fg, dst[0] | (dst[1] << 8), a >> 3);
+      dst[0] = v & 0xFF;
+      dst[1] = v >> 8;
+    }
+    return;
+  }
+
+  if (key == nullptr) {
+    // Sans couleur clé, la ligne est un flux d'octets mélangés à l'identique
+    size_t len = (size_t) count * 3;
+    for (; len >= 4; len -= 4, src += 4, dst += 4) {
+      uint32_t f, b;
+      memcpy(&f, src, 4);
+      memcpy(&b, dst, 4);
+      b = blend_bytes4(f, b, a);
+      memcpy(dst, &b, 4);
+    }
+    for (; len > 0; len--) {
+      *dst = blend_byte(*src++, *dst, a);
+      dst++;
+    }
+    return;
+  }
+
+  for (int i = 0; i < count; i++, src += 3, dst += 3) {
+    if (src[0] == key[0] && src[1] == key[1] && src[2] == key[2]) {
+      continue;
+    }
+    if (alpha == 255) {
+      memcpy(dst, src, 3);
+    } else {
+      dst[0] = blend_byte(src[0], dst[0], a);
+      dst[1] = blend_byte(src[1], dst[1], a);
+      dst[2] = blend_byte(src[2], dst[2], a);
+    }
+  }
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
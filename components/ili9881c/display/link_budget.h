@@ -0,0 +1,47 @@
+#pragma once
+
+#include "esphome/components/dsi_phy/phy_timing.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace ili9881c {
+
+// Débit maximal d'une lane de données du PHY D-PHY de l'ESP32-P4
+static constexpr uint16_t DSI_MAX_LANE_BIT_RATE_MBPS = 1500;
+
+// Octets ajoutés à chaque ligne active : en-tête (4) et CRC (2) du paquet de
+// pixels, plus les paquets courts HSS et HSE (4 chacun)
+static constexpr uint32_t DSI_LINE_OVERHEAD_BYTES = 6 + 2 * 4;
+
+// Résultat du planificateur de liaison (reflet de celui de __init__.py)
+struct LinkBudget {
+  float refresh_rate;    // Hz
+  float required_mbps;   // débit par lane nécessaire pour tenir une ligne
+  float utilization;     // required_mbps / débit configuré (> 1 : hors budget)
+};
+
+// En mode vidéo burst, chaque ligne active doit passer sur les lanes pendant
+// une période de ligne DPI, moins le passage LP -> HS -> LP du PHY
+inline LinkBudget plan_link(uint16_t width, uint32_t h_total, uint32_t v_total, uint8_t bits_per_pixel,
+                            uint8_t lanes, uint16_t lane_mbps, uint8_t dpi_clk_mhz) {
+  LinkBudget budget{};
+  budget.refresh_rate = dpi_clk_mhz * 1e6f / (h_total * v_total);
+
+  const float line_ns = h_total * 1000.0f / dpi_clk_mhz;
+  const dsi_phy::PhyTimings phy = dsi_phy::calculate_phy_timings(lane_mbps * 1000000u);
+  const float transition_ns = phy.hs_transition_bits() * 1000.0f / lane_mbps;
+  const uint32_t line_bytes = (width * bits_per_pixel + 7) / 8 + DSI_LINE_OVERHEAD_BYTES;
+  const float lane_bits = line_bytes * 8.0f / lanes;
+
+  if (line_ns <= transition_ns) {
+    budget.required_mbps = 1e9f;
+  } else {
+    budget.required_mbps = lane_bits * 1000.0f / (line_ns - transition_ns);
+  }
+  budget.utilization = budget.required_mbps / lane_mbps;
+  return budget;
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
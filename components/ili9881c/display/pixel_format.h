@@ -0,0 +1,124 @@
+#pragma once
+
+#include "esphome/core/color.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace esphome {
+namespace ili9881c {
+
+enum PixelFormat : uint8_t {
+  PIXEL_FORMAT_RGB565 = 0,
+  PIXEL_FORMAT_RGB666 = 1,
+  PIXEL_FORMAT_RGB888 = 2,
+};
+
+// Écrit un pixel dans le format natif du framebuffer ; x/y ne servent qu'au tramage
+using PixelWriteFn = void (*)(uint8_t *dst, int x, int y, Color color);
+
+// Matrice de Bayer 4x4 pour le tramage ordonné (valeurs 0..15)
+static constexpr uint8_t BAYER_4X4[4][4] = {
+  {0, 8, 2, 10},
+  {12, 4, 14, 6},
+  {3, 11, 1, 9},
+  {15, 7, 13, 5},
+};
+
+inline uint8_t bytes_per_pixel(PixelFormat format) { return format == PIXEL_FORMAT_RGB565 ? 2 : 3; }
+
+// Écriture d'un pixel spécialisée à la compilation : aucun test de format,
+// d'inversion ou d'ordre des couleurs dans la boucle chaude.
+template<PixelFormat FORMAT, bool INVERT, bool BGR, bool DITHER>
+void write_pixel(uint8_t *dst, int x, int y, Color color) {
+  uint8_t r = INVERT ? 255 - color.red : color.red;
+  uint8_t g = INVERT ? 255 - color.green : color.green;
+  uint8_t b = INVERT ? 255 - color.blue : color.blue;
+  if (BGR) {
+    std::swap(r, b);
+  }
+
+  if constexpr (FORMAT == PIXEL_FORMAT_RGB565) {
+    if constexpr (DITHER) {
+      // Seuil de Bayer ramené au pas de quantification (8 pour R/B, 4 pour G)
+      uint8_t t = BAYER_4X4[y & 3][x & 3];
+      r = std::min(255, r + (t >> 1));
+      g = std::min(255, g + (t >> 2));
+      b = std::min(255, b + (t >> 1));
+    }
+    uint16_t v = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    dst[0] = v & 0xFF;
+    dst[1] = v >> 8;
+  } else if constexpr (FORMAT == PIXEL_FORMAT_RGB666) {
+    if constexpr (DITHER) {
+      uint8_t t = BAYER_4X4[y & 3][x & 3] >> 2;
+      r = std::min(255, r + t);
+      g = std::min(255, g + t);
+      b = std::min(255, b + t);
+    }
+    // Stocké en RGB888, 2 bits bas à zéro : le pont DPI n'en transmet que les 6 bits hauts
+    dst[0] = r & 0xFC;
+    dst[1] = g & 0xFC;
+    dst[2] = b & 0xFC;
+  } else {
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+  }
+}
+
+// Lecture inverse de write_pixel (sans tramage), utilisée pour le mélange alpha
+template<PixelFormat FORMAT, bool INVERT, bool BGR>
+inline void read_pixel(const uint8_t *src, uint8_t &r, uint8_t &g, uint8_t &b) {
+  if constexpr (FORMAT == PIXEL_FORMAT_RGB565) {
+    uint16_t v = src[0] | (src[1] << 8);
+    r = ((v >> 8) & 0xF8) | (v >> 13);
+    g = ((v >> 3) & 0xFC) | ((v >> 9) & 0x03);
+    b = ((v << 3) & 0xF8) | ((v >> 2) & 0x07);
+  } else {
+    r = src[0];
+    g = src[1];
+    b = src[2];
+  }
+  if (BGR) {
+    std::swap(r, b);
+  }
+  if (INVERT) {
+    r = 255 - r;
+    g = 255 - g;
+    b = 255 - b;
+  }
+}
+
+template<PixelFormat FORMAT, bool INVERT, bool BGR>
+PixelWriteFn select_pixel_writer(bool dither) {
+  // Le RGB888 n'a pas de quantification à tramer
+  if (dither && FORMAT != PIXEL_FORMAT_RGB888) {
+    return &write_pixel<FORMAT, INVERT, BGR, true>;
+  }
+  return &write_pixel<FORMAT, INVERT, BGR, false>;
+}
+
+template<PixelFormat FORMAT>
+PixelWriteFn select_pixel_writer(bool invert, bool bgr, bool dither) {
+  if (invert) {
+    return bgr ? select_pixel_writer<FORMAT, true, true>(dither) : select_pixel_writer<FORMAT, true, false>(dither);
+  }
+  return bgr ? select_pixel_writer<FORMAT, false, true>(dither) : select_pixel_writer<FORMAT, false, false>(dither);
+}
+
+// Choisit, une fois pour toutes, l'instanciation correspondant à la configuration
+inline PixelWriteFn select_pixel_writer(PixelFormat format, bool invert, bool bgr, bool dither) {
+  switch (format) {
+    case PIXEL_FORMAT_RGB565:
+      return select_pixel_writer<PIXEL_FORMAT_RGB565>(invert, bgr, dither);
+    case PIXEL_FORMAT_RGB666:
+      return select_pixel_writer<PIXEL_FORMAT_RGB666>(invert, bgr, dither);
+    case PIXEL_FORMAT_RGB888:
+    default:
+      return select_pixel_writer<PIXEL_FORMAT_RGB888>(invert, bgr, dither);
+  }
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace ili9881c {
+
+enum Rotation : uint8_t {
+  ROTATION_0 = 0,
+  ROTATION_90 = 1,
+  ROTATION_180 = 2,
+  ROTATION_270 = 3,
+};
+
+enum RotationMode : uint8_t {
+  // Coordonnées transformées à chaque écriture, buffer dans l'orientation du panel
+  ROTATION_MODE_DRAW = 0,
+  // Rendu dans l'orientation logique, transposé par blocs au moment du flush
+  ROTATION_MODE_FLUSH = 1,
+};
+
+// Côté des tuiles du transposé par blocs (32 lignes de destination restent en cache)
+static constexpr int ROTATION_TILE = 32;
+
+inline bool rotation_swaps_axes(Rotation rotation) {
+  return rotation == ROTATION_90 || rotation == ROTATION_270;
+}
+
+// Coordonnées logiques -> physiques (rotation horaire), pw/ph : taille physique
+inline void rotate_point(Rotation rotation, int x, int y, int pw, int ph, int &px, int &py) {
+  switch (rotation) {
+    case ROTATION_0:
+    default: px = x; py = y; break;
+    case ROTATION_90: px = pw - 1 - y; py = x; break;
+    case ROTATION_180: px = pw - 1 - x; py = ph - 1 - y; break;
+    case ROTATION_270: px = y; py = ph - 1 - x; break;
+  }
+}
+
+// Rectangle logique [x1, x2) x [y1, y2) -> rectangle physique
+inline void rotate_rect(Rotation rotation, int pw, int ph, int &x1, int &y1, int &x2, int &y2) {
+  int rx1 = x1, ry1 = y1, rx2 = x2, ry2 = y2;
+  switch (rotation) {
+    case ROTATION_0: return;
+    case ROTATION_90: rx1 = pw - y2; rx2 = pw - y1; ry1 = x1; ry2 = x2; break;
+    case ROTATION_180: rx1 = pw - x2; rx2 = pw - x1; ry1 = ph - y2; ry2 = ph - y1; break;
+    case ROTATION_270: rx1 = y1; rx2 = y2; ry1 = ph - x2; ry2 = ph - x1; break;
+  }
+  x1 = rx1; y1 = ry1; x2 = rx2; y2 = ry2;
+}
+
+// Pas (en octets) dans le buffer physique pour x+1 et y+1 logiques
+inline void rotation_steps(Rotation rotation, uint8_t bpp, size_t stride, ptrdiff_t &step_x, ptrdiff_t &step_y) {
+  const ptrdiff_t s = (ptrdiff_t) stride;
+  switch (rotation) {
+    case ROTATION_0:
+    default: step_x = bpp; step_y = s; break;
+    case ROTATION_90: step_x = s; step_y = -bpp; break;
+    case ROTATION_180: step_x = -bpp; step_y = -s; break;
+    case ROTATION_270: step_x = -s; step_y = bpp; break;
+  }
+}
+
+// Copie un bloc w x h en avançant dans la destination avec des pas arbitraires
+template<uint8_t BPP>
+void copy_block_stepped(const uint8_t *src, size_t src_stride, int w, int h, uint8_t *dst, ptrdiff_t step_x,
+                        ptrdiff_t step_y) {
+  for (int y = 0; y < h; y++) {
+    const uint8_t *s = src + y * src_stride;
+    uint8_t *d = dst + y * step_y;
+    if (step_x == BPP) {
+      memcpy(d, s, (size_t) w * BPP);
+      continue;
+    }
+    for (int x = 0; x < w; x++) {
+      memcpy(d, s, BPP);
+      s += BPP;
+      d += step_x;
+    }
+  }
+}
+
+// Transposé par tuiles d'un bloc w x h placé en (x, y) dans l'image logique.
+// src pointe sur le premier pixel du bloc ; dst/dst_stride/pw/ph : buffer physique.
+template<uint8_t BPP>
+void rotate_tiles(Rotation rotation, const uint8_t *src, size_t src_stride, int x, int y, int w, int h, uint8_t *dst,
+                  size_t dst_stride, int pw, int ph) {
+  ptrdiff_t step_x, step_y;
+  rotation_steps(rotation, BPP, dst_stride, step_x, step_y);
+  for (int ty = 0; ty < h; ty += ROTATION_TILE) {
+    const int th = (ty + ROTATION_TILE <= h) ? ROTATION_TILE : h - ty;
+    for (int tx = 0; tx < w; tx += ROTATION_TILE) {
+      const int tw = (tx + ROTATION_TILE <= w) ? ROTATION_TILE : w - tx;
+      int px, py;
+      rotate_point(rotation, x + tx, y + ty, pw, ph, px, py);
+      copy_block_stepped<BPP>(src + ty * src_stride + tx * BPP, src_stride, tw, th,
+                              dst + py * dst_stride + px * BPP, step_x, step_y);
+    }
+  }
+}
+
+// Transposé par tuiles d'un rectangle logique du buffer source vers le buffer physique.
+// src/src_stride : buffer logique ; dst/dst_stride/pw/ph : buffer physique.
+template<uint8_t BPP>
+void rotate_block(Rotation rotation, const uint8_t *src, size_t src_stride, int x, int y, int w, int h, uint8_t *dst,
+                  size_t dst_stride, int pw, int ph) {
+  rotate_tiles<BPP>(rotation, src + y * src_stride + x * BPP, src_stride, x, y, w, h, dst, dst_stride, pw, ph);
+}
+
+}  // namespace ili9881c
+}  // namespace esphome
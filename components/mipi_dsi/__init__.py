@@ -4,6 +4,7 @@ from esphome.const import CONF_ID
 from esphome.components import esp32
 
 DEPENDENCIES = ['esp32']
+AUTO_LOAD = ['dsi_phy']
 CODEOWNERS = ['@your_username']
 
 mipi_dsi_ns = cg.esphome_ns.namespace('mipi_dsi')
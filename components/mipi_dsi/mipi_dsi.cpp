@@ -1,3 +1,11 @@
+#include "mipi_dsi.h"
+#include "packet.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace mipi_dsi {
 
@@ -94,104 +102,157 @@ bool MIPIDSIComponent::configure_clock_lane() {
 bool MIPIDSIComponent::calculate_phy_timings() {
   ESP_LOGD(TAG, "Calculating PHY timings...");
   
-  // Calcul des timings basés sur le bit rate
-  // Ces valeurs sont approximatives et dépendent du PHY spécifique
-  float bit_period_ns = 1000000000.0 / this->bit_rate_;
-  
-  this->phy_timings_.hs_prepare = (uint16_t) (40 / bit_period_ns);
-  this->phy_timings_.hs_zero = (uint16_t) (105 / bit_period_ns);
-  this->phy_timings_.hs_trail = (uint16_t) (max(8 * bit_period_ns, 60.0) / bit_period_ns);
-  this->phy_timings_.hs_exit = (uint16_t) (100 / bit_period_ns);
-  
-  this->phy_timings_.clk_prepare = (uint16_t) (38 / bit_period_ns);
-  this->phy_timings_.clk_zero = (uint16_t) (262 / bit_period_ns);
-  this->phy_timings_.clk_trail = (uint16_t) (60 / bit_period_ns);
-  this->phy_timings_.clk_post = (uint16_t) (60 / bit_period_ns);
-  this->phy_timings_.clk_pre = (uint16_t) (8 / bit_period_ns);
+  this->phy_timings_ = dsi_phy::calculate_phy_timings(this->bit_rate_);
   
   ESP_LOGD(TAG, "PHY timings calculated successfully");
   return true;
 }
 
 bool MIPIDSIComponent::send_dcs_command(uint8_t cmd, const uint8_t *data, size_t len) {
+  return this->queue_dcs_command(cmd, data, len) && this->flush_queue();
+}
+
+bool MIPIDSIComponent::send_generic_command(uint8_t cmd, const uint8_t *data, size_t len) {
+  return this->queue_generic_command(cmd, data, len) && this->flush_queue();
+}
+
+bool MIPIDSIComponent::queue_dcs_command(uint8_t cmd, const uint8_t *data, size_t len) {
   if (!this->is_initialized_) {
     ESP_LOGE(TAG, "MIPI DSI not initialized");
     return false;
   }
   
   if (len == 0) {
-    return this->send_short_packet(MIPI_DSI_DCS_SHORT_WRITE, cmd);
+    return this->queue_short_packet_(MIPI_DSI_DCS_SHORT_WRITE, cmd, 0);
   } else if (len == 1) {
-    return this->send_short_packet(MIPI_DSI_DCS_SHORT_WRITE_PARAM, (data[0] << 8) | cmd);
-  } else {
-    // Préparer le paquet long
-    uint8_t *packet_data = new uint8_t[len + 1];
-    packet_data[0] = cmd;
-    memcpy(packet_data + 1, data, len);
-    
-    bool result = this->send_long_packet(MIPI_DSI_DCS_LONG_WRITE, packet_data, len + 1);
-    delete[] packet_data;
-    return result;
+    return this->queue_short_packet_(MIPI_DSI_DCS_SHORT_WRITE_PARAM, cmd, data[0]);
   }
+  // Paquet long : la commande est le premier octet de la charge utile
+  return this->queue_long_packet_(MIPI_DSI_DCS_LONG_WRITE, &cmd, 1, data, len);
 }
 
-bool MIPIDSIComponent::send_generic_command(uint8_t cmd, const uint8_t *data, size_t len) {
+bool MIPIDSIComponent::queue_generic_command(uint8_t cmd, const uint8_t *data, size_t len) {
   if (!this->is_initialized_) {
     ESP_LOGE(TAG, "MIPI DSI not initialized");
     return false;
   }
   
+  // Le nombre de paramètres des écritures génériques courtes inclut le premier octet
   if (len == 0) {
-    return this->send_short_packet(MIPI_DSI_GENERIC_SHORT_WRITE_0, cmd);
+    return this->queue_short_packet_(MIPI_DSI_GENERIC_SHORT_WRITE_1, cmd, 0);
   } else if (len == 1) {
-    return this->send_short_packet(MIPI_DSI_GENERIC_SHORT_WRITE_1, (data[0] << 8) | cmd);
-  } else if (len == 2) {
-    return this->send_short_packet(MIPI_DSI_GENERIC_SHORT_WRITE_2, (data[1] << 16) | (data[0] << 8) | cmd);
-  } else {
-    uint8_t *packet_data = new uint8_t[len + 1];
-    packet_data[0] = cmd;
-    memcpy(packet_data + 1, data, len);
-    
-    bool result = this->send_long_packet(MIPI_DSI_GENERIC_LONG_WRITE, packet_data, len + 1);
-    delete[] packet_data;
-    return result;
+    return this->queue_short_packet_(MIPI_DSI_GENERIC_SHORT_WRITE_2, cmd, data[0]);
   }
+  return this->queue_long_packet_(MIPI_DSI_GENERIC_LONG_WRITE, &cmd, 1, data, len);
 }
 
 bool MIPIDSIComponent::send_short_packet(uint8_t data_type, uint16_t data) {
   ESP_LOGV(TAG, "Sending short packet: type=0x%02X, data=0x%04X", data_type, data);
-  
-  // Construction du paquet court (4 bytes)
-  uint8_t packet[4];
+  return this->queue_short_packet_(data_type, data & 0xFF, (data >> 8) & 0xFF) && this->flush_queue();
+}
+
+bool MIPIDSIComponent::send_long_packet(uint8_t data_type, const uint8_t *data, size_t len) {
+  ESP_LOGV(TAG, "Sending long packet: type=0x%02X, len=%u", data_type, (unsigned) len);
+  return this->queue_long_packet_(data_type, nullptr, 0, data, len) && this->flush_queue();
+}
+
+bool MIPIDSIComponent::queue_short_packet_(uint8_t data_type, uint8_t data0, uint8_t data1) {
+  // Paquet court (4 octets) : DI, deux octets de données, ECC
+  uint8_t *packet = this->reserve_(4);
+  if (packet == nullptr) {
+    return false;
+  }
   packet[0] = data_type;
-  packet[1] = data & 0xFF;
-  packet[2] = (data >> 8) & 0xFF;
-  packet[3] = this->calculate_checksum(packet, 3);
-  
-  // Ici, il faudrait envoyer le paquet via le contrôleur MIPI DSI
-  // Cette partie nécessite l'accès aux registres spécifiques du ESP32
-  
-  ESP_LOGV(TAG, "Short packet sent successfully");
+  packet[1] = data0;
+  packet[2] = data1;
+  packet[3] = dsi_header_ecc(packet);
   return true;
 }
 
-bool MIPIDSIComponent::send_long_packet(uint8_t data_type, const uint8_t *data, size_t len) {
-  ESP_LOGV(TAG, "Sending long packet: type=0x%02X, len=%d", data_type, len);
+bool MIPIDSIComponent::queue_long_packet_(uint8_t data_type, const uint8_t *prefix, size_t prefix_len,
+                                          const uint8_t *data, size_t len) {
+  // Paquet long : en-tête (DI, nombre de mots, ECC), charge utile, checksum 16 bits
+  const size_t payload = prefix_len + len;
+  uint8_t *packet = this->reserve_(4 + payload + 2);
+  if (packet == nullptr) {
+    return false;
+  }
+  packet[0] = data_type;
+  packet[1] = payload & 0xFF;
+  packet[2] = (payload >> 8) & 0xFF;
+  packet[3] = dsi_header_ecc(packet);
+  if (prefix_len > 0) {
+    memcpy(packet + 4, prefix, prefix_len);
+  }
+  if (len > 0) {
+    memcpy(packet + 4 + prefix_len, data, len);
+  }
+  uint16_t checksum = dsi_crc16(packet + 4, payload);
+  packet[4 + payload] = checksum & 0xFF;
+  packet[5 + payload] = checksum >> 8;
+  return true;
+}
+
+uint8_t *MIPIDSIComponent::reserve_(size_t size) {
+  // Un paquet plus grand que DSI_MAX_TRANSFER reste accepté (drain_ l'envoie seul),
+  // mais il doit tenir dans la file
+  if (size > DSI_QUEUE_SIZE) {
+    ESP_LOGE(TAG, "Packet of %u bytes exceeds the %u byte queue", (unsigned) size, (unsigned) DSI_QUEUE_SIZE);
+    return nullptr;
+  }
   
-  // Construction de l'en-tête du paquet long (4 bytes)
-  uint8_t header[4];
-  header[0] = data_type;
-  header[1] = len & 0xFF;
-  header[2] = (len >> 8) & 0xFF;
-  header[3] = this->calculate_checksum(header, 3);
+  // File pleine : transmettre ce qui est en attente avant d'ajouter le paquet
+  if (DSI_QUEUE_SIZE - this->queue_used_ < size && !this->flush_queue()) {
+    return nullptr;
+  }
+  uint8_t *ptr = this->queue_ + this->queue_used_;
+  this->queue_used_ += size;
+  return ptr;
+}
+
+bool MIPIDSIComponent::flush_queue(dsi_flush_callback_t &&callback) {
+  bool success = this->drain_(this->queue_, this->queue_used_);
   
-  // Calcul du checksum des données
-  uint16_t data_checksum = this->calculate_checksum(data, len);
+  // Les paquets non transmis sont abandonnés : la file repart vide
+  this->queue_used_ = 0;
   
-  // Ici, il faudrait envoyer l'en-tête, les données et le checksum
-  // via le contrôleur MIPI DSI
+  if (callback) {
+    callback(success);
+  }
+  return success;
+}
+
+bool MIPIDSIComponent::drain_(const uint8_t *data, size_t len) {
+  // Regroupe les paquets consécutifs en transferts d'au plus DSI_MAX_TRANSFER octets ;
+  // un paquet plus grand part seul dans son propre transfert
+  size_t start = 0;
+  size_t pos = 0;
+  while (pos < len) {
+    size_t packet_len = 4;
+    if (dsi_is_long_packet(data[pos])) {
+      packet_len += (data[pos + 1] | (data[pos + 2] << 8)) + 2;
+    }
+    if (pos > start && pos + packet_len - start > DSI_MAX_TRANSFER) {
+      if (!this->transmit_(data + start, pos - start)) {
+        return false;
+      }
+      start = pos;
+    }
+    pos += packet_len;
+  }
+  if (pos > start) {
+    return this->transmit_(data + start, pos - start);
+  }
+  return true;
+}
+
+bool MIPIDSIComponent::transmit_(const uint8_t *data, size_t len) {
+  ESP_LOGV(TAG, "Transferring %u bytes of packets", (unsigned) len);
+  
+  // Ici, il faudrait écrire les paquets dans la FIFO de commandes du
+  // contrôleur MIPI DSI. Cette partie nécessite l'accès aux registres
+  // spécifiques du ESP32
   
-  ESP_LOGV(TAG, "Long packet sent successfully");
   return true;
 }
 
@@ -213,13 +274,5 @@ bool MIPIDSIComponent::set_hs_mode(bool enable) {
   return true;
 }
 
-uint16_t MIPIDSIComponent::calculate_checksum(const uint8_t *data, size_t len) {
-  uint16_t checksum = 0;
-  for (size_t i = 0; i < len; i++) {
-    checksum += data[i];
-  }
-  return checksum;
-}
-
 }  // namespace mipi_dsi
 }  // namespace esphome
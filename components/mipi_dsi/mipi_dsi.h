@@ -1,7 +1,24 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/dsi_phy/phy_timing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
 namespace esphome {
 namespace mipi_dsi {
 
-static const char *const TAG = "mipi_dsi";
+// File de paquets préallouée (octets de paquets encodés, en-têtes et CRC compris)
+static const size_t DSI_QUEUE_SIZE = 1024;
+// Taille visée pour un transfert vers le contrôleur (plusieurs paquets regroupés) ;
+// un paquet plus grand est transféré seul
+static const size_t DSI_MAX_TRANSFER = 256;
+
+using dsi_flush_callback_t = std::function<void(bool success)>;
+
+using dsi_phy::PhyTimings;
 
 class MIPIDSIComponent : public Component {
  public:
@@ -13,10 +30,18 @@ class MIPIDSIComponent : public Component {
   void set_bit_rate(uint32_t bit_rate) { this->bit_rate_ = bit_rate; }
   void set_phy_voltage(uint16_t voltage) { this->phy_voltage_ = voltage; }
 
-  // Méthodes pour l'envoi de commandes DCS (Display Command Set)
+  // Méthodes pour l'envoi de commandes DCS (Display Command Set), envoyées immédiatement
   bool send_dcs_command(uint8_t cmd, const uint8_t *data = nullptr, size_t len = 0);
   bool send_generic_command(uint8_t cmd, const uint8_t *data = nullptr, size_t len = 0);
   
+  // Envoi groupé : les commandes sont encodées dans la file puis transmises par
+  // flush_queue() en aussi peu de transferts que possible. Une file pleine est
+  // vidée automatiquement.
+  bool queue_dcs_command(uint8_t cmd, const uint8_t *data = nullptr, size_t len = 0);
+  bool queue_generic_command(uint8_t cmd, const uint8_t *data = nullptr, size_t len = 0);
+  bool flush_queue(dsi_flush_callback_t &&callback = nullptr);
+  size_t get_queue_used() const { return this->queue_used_; }
+  
   // Méthodes pour la gestion des paquets MIPI
   bool send_short_packet(uint8_t data_type, uint16_t data);
   bool send_long_packet(uint8_t data_type, const uint8_t *data, size_t len);
@@ -30,6 +55,7 @@ class MIPIDSIComponent : public Component {
   uint8_t get_number_of_lanes() const { return this->number_of_lanes_; }
   uint32_t get_bit_rate() const { return this->bit_rate_; }
   uint16_t get_phy_voltage() const { return this->phy_voltage_; }
+  const PhyTimings &get_phy_timings() const { return this->phy_timings_; }
 
  protected:
   uint8_t number_of_lanes_{2};
@@ -43,23 +69,24 @@ class MIPIDSIComponent : public Component {
   bool calculate_phy_timings();
   bool configure_clock_lane();
   bool configure_data_lanes();
-  uint16_t calculate_checksum(const uint8_t *data, size_t len);
   
-  // Structures pour les timings PHY
-  struct phy_timings {
-    uint16_t hs_prepare;
-    uint16_t hs_zero;
-    uint16_t hs_trail;
-    uint16_t hs_exit;
-    uint16_t clk_prepare;
-    uint16_t clk_zero;
-    uint16_t clk_trail;
-    uint16_t clk_post;
-    uint16_t clk_pre;
-  } phy_timings_;
+  // File de paquets
+  bool queue_short_packet_(uint8_t data_type, uint8_t data0, uint8_t data1);
+  bool queue_long_packet_(uint8_t data_type, const uint8_t *prefix, size_t prefix_len, const uint8_t *data,
+                          size_t len);
+  uint8_t *reserve_(size_t size);
+  bool drain_(const uint8_t *data, size_t len);
+  bool transmit_(const uint8_t *data, size_t len);
+  
+  // Paquets encodés en attente, dans l'ordre d'envoi ; vidé entièrement à chaque flush
+  uint8_t queue_[DSI_QUEUE_SIZE];
+  size_t queue_used_{0};
+  
+  // Timings PHY au débit configuré
+  PhyTimings phy_timings_;
 };
 
-// Types de paquets MIPI DSI
+// Types de paquets MIPI DSI (paquets longs : voir dsi_is_long_packet)
 enum MIPIPacketType {
   MIPI_DSI_V_SYNC_START = 0x01,
   MIPI_DSI_V_SYNC_END = 0x11,
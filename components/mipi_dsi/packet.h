@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace mipi_dsi {
+
+// ECC de l'en-tête de paquet (spécification DSI) : code de Hamming sur les
+// 24 bits DI / données, 6 bits de parité, bits 6 et 7 à zéro.
+// Masques des bits de données couverts par chaque bit de parité P0..P5.
+static constexpr uint32_t ECC_MASKS[6] = {
+  0xF12CB7,  // P0 : D0 D1 D2 D4 D5 D7 D10 D11 D13 D16 D20 D21 D22 D23
+  0xF2555B,  // P1 : D0 D1 D3 D4 D6 D8 D10 D12 D14 D17 D20 D21 D22 D23
+  0x749A6D,  // P2 : D0 D2 D3 D5 D6 D9 D11 D12 D15 D18 D20 D21 D22
+  0xB8E38E,  // P3 : D1 D2 D3 D7 D8 D9 D13 D14 D15 D19 D20 D21 D23
+  0xDF03F0,  // P4 : D4 D5 D6 D7 D8 D9 D16 D17 D18 D19 D20 D22 D23
+  0xEFFC00,  // P5 : D10..D19 D21 D22 D23
+};
+
+constexpr uint8_t ecc_of_bits(uint32_t bits) {
+  uint8_t ecc = 0;
+  for (int p = 0; p < 6; p++) {
+    uint32_t v = bits & ECC_MASKS[p];
+    uint8_t parity = 0;
+    while (v != 0) {
+      parity ^= v & 1;
+      v >>= 1;
+    }
+    ecc |= parity << p;
+  }
+  return ecc;
+}
+
+// L'ECC est linéaire : une table de 256 entrées par octet d'en-tête
+struct EccTables {
+  uint8_t byte[3][256];
+  constexpr EccTables() : byte() {
+    for (int b = 0; b < 3; b++) {
+      for (int v = 0; v < 256; v++) {
+        byte[b][v] = ecc_of_bits((uint32_t) v << (8 * b));
+      }
+    }
+  }
+};
+
+static constexpr EccTables ECC_TABLES{};
+
+inline uint8_t dsi_header_ecc(const uint8_t *header) {
+  return ECC_TABLES.byte[0][header[0]] ^ ECC_TABLES.byte[1][header[1]] ^ ECC_TABLES.byte[2][header[2]];
+}
+
+// Types de données des paquets longs (spécification DSI) ; tous les autres, EoTp (0x08)
+// compris, sont des paquets courts de 4 octets
+inline bool dsi_is_long_packet(uint8_t data_type) {
+  switch (data_type & 0x3F) {
+    case 0x09:  // Null
+    case 0x19:  // Blanking
+    case 0x29:  // Generic long write
+    case 0x39:  // DCS long write
+    case 0x0A:  // Picture parameter set
+    case 0x0B:  // Flux de pixels compressés
+    case 0x0C:  // YCbCr 4:2:2 20 bits étendu
+    case 0x1C:  // YCbCr 4:2:2 24 bits
+    case 0x2C:  // YCbCr 4:2:2 16 bits
+    case 0x0D:  // RGB 30 bits
+    case 0x1D:  // RGB 36 bits
+    case 0x3D:  // YCbCr 4:2:0 12 bits
+    case 0x0E:  // RGB565
+    case 0x1E:  // RGB666 compacté
+    case 0x2E:  // RGB666 étendu
+    case 0x3E:  // RGB888
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Checksum de la charge utile des paquets longs : CRC-16 CCITT (x^16 + x^12 + x^5 + 1)
+// réfléchi (0x8408), initialisé à 0xFFFF, sans inversion finale
+static constexpr uint16_t CRC16_POLY = 0x8408;
+static constexpr uint16_t CRC16_INIT = 0xFFFF;
+
+// Tables du "slicing-by-4" : slice[0] est la table classique octet par octet,
+// slice[n] avance de n octets supplémentaires
+struct Crc16Tables {
+  uint16_t slice[4][256];
+  constexpr Crc16Tables() : slice() {
+    for (int v = 0; v < 256; v++) {
+      uint16_t crc = v;
+      for (int i = 0; i < 8; i++) {
+        crc = (crc & 1) ? (crc >> 1) ^ CRC16_POLY : crc >> 1;
+      }
+      slice[0][v] = crc;
+    }
+    for (int n = 1; n < 4; n++) {
+      for (int v = 0; v < 256; v++) {
+        uint16_t prev = slice[n - 1][v];
+        slice[n][v] = (prev >> 8) ^ slice[0][prev & 0xFF];
+      }
+    }
+  }
+};
+
+static constexpr Crc16Tables CRC16_TABLES{};
+
+inline uint16_t dsi_crc16(const uint8_t *data, size_t len, uint16_t crc = CRC16_INIT) {
+  const auto &t = CRC16_TABLES.slice;
+  // Quatre octets par itération
+  for (; len >= 4; len -= 4, data += 4) {
+    const uint8_t b0 = data[0] ^ (crc & 0xFF);
+    const uint8_t b1 = data[1] ^ (crc >> 8);
+    crc = t[3][b0] ^ t[2][b1] ^ t[1][data[2]] ^ t[0][data[3]];
+  }
+  for (; len > 0; len--, data++) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+  }
+  return crc;
+}
+
+}  // namespace mipi_dsi
+}  // namespace esphome
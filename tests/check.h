@@ -0,0 +1,25 @@
+#pragma once
+
+// Vérifications des tests hôte : les échecs sont comptés et affichés, le test
+// continue et main() renvoie check_result()
+
+#include <cstdio>
+
+static int check_failures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      check_failures++; \
+    } \
+  } while (0)
+
+static inline int check_result(const char *name) {
+  if (check_failures > 0) {
+    printf("%s: %d check(s) failed\n", name, check_failures);
+    return 1;
+  }
+  printf("%s: all checks passed\n", name);
+  return 0;
+}
@@ -0,0 +1,142 @@
+// Régression du suivi des zones modifiées : fusion des rectangles dans
+// mark_dirty_(), bandes de lignes de build_flush_bands_() et octets réellement
+// envoyés au panel par update().
+
+#include "check.h"
+#include "host_display.h"
+
+#include <cstdlib>
+
+using namespace esphome;
+using namespace esphome::ili9881c;
+
+static const int WIDTH = 720;
+static const int HEIGHT = 1280;
+
+static bool covers(const DirtyRect *rects, uint8_t count, int x, int y) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (x >= rects[i].x1 && x < rects[i].x2 && y >= rects[i].y1 && y < rects[i].y2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void test_merge() {
+  HostDisplay display;
+
+  // Zone contenue dans une zone existante : rien d'ajouté
+  display.mark_dirty_(100, 100, 200, 200);
+  display.mark_dirty_(120, 120, 180, 180);
+  CHECK(display.dirty_count_ == 1);
+
+  // Zone voisine (écart inférieur à DIRTY_MERGE_GAP) : la zone s'agrandit
+  display.mark_dirty_(200 + DIRTY_MERGE_GAP, 100, 260, 150);
+  CHECK(display.dirty_count_ == 1);
+  CHECK(display.dirty_rects_[0].x2 == 260);
+
+  // Zone éloignée : conservée à part
+  display.mark_dirty_(500, 1000, 600, 1100);
+  CHECK(display.dirty_count_ == 2);
+
+  // Zone qui relie les deux : tout est absorbé en une seule
+  display.mark_dirty_(150, 190, 560, 1010);
+  CHECK(display.dirty_count_ == 1);
+  const DirtyRect &r = display.dirty_rects_[0];
+  CHECK(r.x1 == 100 && r.y1 == 100 && r.x2 == 600 && r.y2 == 1100);
+
+  // Coordonnées hors écran bornées au buffer, zones vides ignorées
+  HostDisplay clipped;
+  clipped.mark_dirty_(-50, -50, 10, 10);
+  clipped.mark_dirty_(WIDTH - 5, HEIGHT - 5, WIDTH + 50, HEIGHT + 50);
+  clipped.mark_dirty_(300, 300, 300, 400);
+  CHECK(clipped.dirty_count_ == 2);
+  CHECK(clipped.dirty_rects_[0].x1 == 0 && clipped.dirty_rects_[0].y1 == 0);
+  CHECK(clipped.dirty_rects_[1].x2 == WIDTH && clipped.dirty_rects_[1].y2 == HEIGHT);
+}
+
+static void test_overflow() {
+  // Plus de zones éloignées que MAX_DIRTY_RECTS : la liste reste bornée et
+  // couvre toujours chaque pixel marqué
+  HostDisplay display;
+  srand(1);
+  for (int i = 0; i < 200; i++) {
+    const int x = rand() % (WIDTH - 8);
+    const int y = rand() % (HEIGHT - 8);
+    display.mark_dirty_(x, y, x + 4, y + 4);
+    CHECK(display.dirty_count_ <= MAX_DIRTY_RECTS);
+    CHECK(covers(display.dirty_rects_, display.dirty_count_, x, y));
+    CHECK(covers(display.dirty_rects_, display.dirty_count_, x + 3, y + 3));
+  }
+
+  // Aucune paire restante ne se touche (sinon elle aurait été fusionnée)
+  for (uint8_t i = 0; i < display.dirty_count_; i++) {
+    for (uint8_t j = i + 1; j < display.dirty_count_; j++) {
+      const DirtyRect &a = display.dirty_rects_[i];
+      const DirtyRect &b = display.dirty_rects_[j];
+      const bool near = a.x1 <= b.x2 + DIRTY_MERGE_GAP && a.x2 + DIRTY_MERGE_GAP >= b.x1 &&
+                        a.y1 <= b.y2 + DIRTY_MERGE_GAP && a.y2 + DIRTY_MERGE_GAP >= b.y1;
+      CHECK(!near);
+    }
+  }
+}
+
+static void test_bands() {
+  HostDisplay display;
+  DirtyRect bands[MAX_DIRTY_RECTS];
+
+  // Non triées, chevauchantes en y ou contiguës : bandes triées, pleine largeur
+  const DirtyRect rects[5] = {
+      {600, 900, 700, 1000},  // seule
+      {0, 100, 10, 150},      // chevauche la suivante en y
+      {400, 140, 500, 200},
+      {50, 200, 60, 220},     // contiguë à la précédente (y1 == y2)
+      {10, 500, 20, 510},     // seule
+  };
+  const uint8_t count = display.build_flush_bands_(rects, 5, bands);
+  CHECK(count == 3);
+  CHECK(bands[0].y1 == 100 && bands[0].y2 == 220);
+  CHECK(bands[1].y1 == 500 && bands[1].y2 == 510);
+  CHECK(bands[2].y1 == 900 && bands[2].y2 == 1000);
+  for (uint8_t i = 0; i < count; i++) {
+    CHECK(bands[i].x1 == 0 && bands[i].x2 == WIDTH);
+  }
+}
+
+static void test_flushed_bytes() {
+  // Octets envoyés par update() : écran complet au départ, puis seulement les
+  // lignes dessinées par la trame
+  HostDisplay display;
+  display.set_pixel_format(PIXEL_FORMAT_RGB565);
+  display.set_auto_clear_enabled(false);
+  int step = 0;
+  display.set_writer([&step](ILI9881C &it) {
+    if (step == 1) {
+      it.filled_rectangle(100, 200, 50, 20, Color(255, 0, 0));
+    } else if (step == 2) {
+      it.filled_rectangle(100, 200, 50, 20, Color(0, 255, 0));
+      it.filled_rectangle(300, 800, 10, 30, Color(0, 0, 255));
+    }
+  });
+  CHECK(display.bring_up());
+  const uint32_t row_bytes = WIDTH * 2;
+
+  display.update();
+  CHECK(display.get_bytes_flushed() == HEIGHT * row_bytes);
+
+  step = 1;
+  display.update();
+  CHECK(display.get_bytes_flushed() == 20 * row_bytes);
+
+  step = 2;
+  display.update();
+  CHECK(display.get_bytes_flushed() == (20 + 30) * row_bytes);
+}
+
+int main() {
+  test_merge();
+  test_overflow();
+  test_bands();
+  test_flushed_bytes();
+  return check_result("dirty_rects_test");
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+// Afficheur ILI9881C mis en route sur les stubs de l'hôte, avec accès aux
+// membres protégés pour les tests
+
+#include "ili9881c.h"
+
+namespace esphome {
+namespace ili9881c {
+
+class HostDisplay : public ILI9881C {
+ public:
+  // Géométrie et timings du panel 720x1280 de référence
+  HostDisplay() {
+    this->set_dimensions(720, 1280);
+    this->set_data_lanes(2);
+    this->set_lane_bit_rate_mbps(1000);
+    this->set_dpi_clk_freq_mhz(80);
+    this->set_hsync(20);
+    this->set_hbp(40);
+    this->set_hfp(40);
+    this->set_vsync(4);
+    this->set_vbp(10);
+    this->set_vfp(30);
+  }
+
+  // Sans délai dans la séquence d'init, la mise en route se termine en
+  // quelques passages de loop()
+  bool bring_up() {
+    this->setup();
+    for (int i = 0; i < 100 && this->init_state_ != INIT_STATE_READY; i++) {
+      if (this->init_state_ == INIT_STATE_FAILED) {
+        return false;
+      }
+      this->loop();
+    }
+    return this->init_state_ == INIT_STATE_READY;
+  }
+
+  using ILI9881C::build_flush_bands_;
+  using ILI9881C::dirty_count_;
+  using ILI9881C::dirty_rects_;
+  using ILI9881C::mark_dirty_;
+};
+
+}  // namespace ili9881c
+}  // namespace esphome
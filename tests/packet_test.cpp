@@ -0,0 +1,125 @@
+// Vecteurs de codage des paquets DSI : ECC d'en-tête, CRC-16 des charges
+// utiles et classement court / long des types de données.
+
+#include "check.h"
+#include "mipi_dsi.h"
+#include "packet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace esphome::mipi_dsi;
+
+// Références sans tables : ECC calculé directement sur les 24 bits (les masques
+// sont validés par les vecteurs connus), CRC bit à bit
+static uint8_t reference_ecc(const uint8_t *header) {
+  const uint32_t bits = header[0] | (header[1] << 8) | (header[2] << 16);
+  return ecc_of_bits(bits);
+}
+
+static uint16_t reference_crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+    }
+  }
+  return crc;
+}
+
+static void test_header_ecc() {
+  // Exit Sleep et Display On en DCS short write
+  const uint8_t exit_sleep[3] = {MIPI_DSI_DCS_SHORT_WRITE, DCS_EXIT_SLEEP_MODE, 0x00};
+  const uint8_t display_on[3] = {MIPI_DSI_DCS_SHORT_WRITE, DCS_SET_DISPLAY_ON, 0x00};
+  CHECK(dsi_header_ecc(exit_sleep) == 0x36);
+  CHECK(dsi_header_ecc(display_on) == 0x1C);
+
+  // Tables par octet contre le calcul bit à bit, sur un balayage des en-têtes
+  for (uint32_t v = 0; v < (1u << 24); v += 4099) {
+    const uint8_t header[3] = {(uint8_t) v, (uint8_t) (v >> 8), (uint8_t) (v >> 16)};
+    CHECK(dsi_header_ecc(header) == reference_ecc(header));
+    CHECK((dsi_header_ecc(header) & 0xC0) == 0);
+  }
+}
+
+static void test_crc16() {
+  // Valeur de contrôle du CRC-16 CCITT réfléchi
+  const uint8_t check[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  CHECK(dsi_crc16(check, sizeof(check)) == 0x6F91);
+  CHECK(dsi_crc16(check, 0) == 0xFFFF);
+
+  // Toutes les longueurs et alignements de la version par mots
+  std::vector<uint8_t> data(67);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i * 37 + 11;
+  }
+  for (size_t offset = 0; offset < 4; offset++) {
+    for (size_t len = 0; len + offset <= data.size(); len++) {
+      CHECK(dsi_crc16(data.data() + offset, len) == reference_crc16(data.data() + offset, len));
+    }
+  }
+
+  // Calcul en plusieurs morceaux
+  const uint16_t partial = dsi_crc16(check, 4);
+  CHECK(dsi_crc16(check + 4, 5, partial) == 0x6F91);
+}
+
+static void test_packet_classes() {
+  CHECK(!dsi_is_long_packet(0x05));  // DCS short write
+  CHECK(!dsi_is_long_packet(0x15));  // DCS short write, 1 paramètre
+  CHECK(!dsi_is_long_packet(0x08));  // EoTp
+  CHECK(!dsi_is_long_packet(0x37));  // Set maximum return packet size
+  CHECK(dsi_is_long_packet(0x39));   // DCS long write
+  CHECK(dsi_is_long_packet(0x29));   // Generic long write
+  CHECK(dsi_is_long_packet(0x3E));   // Packed pixel stream RGB888
+  // Canal virtuel ignoré
+  CHECK(dsi_is_long_packet(0x39 | 0xC0));
+  CHECK(!dsi_is_long_packet(0x05 | 0x40));
+}
+
+static void test_queue_long_packets() {
+  MIPIDSIComponent dsi;
+  dsi.setup();
+  CHECK(!dsi.is_failed());
+
+  // Paquets plus grands qu'un transfert groupé (LUT, gamma) : acceptés et mis
+  // en file avec en-tête et CRC
+  std::vector<uint8_t> lut(300);
+  for (size_t i = 0; i < lut.size(); i++) {
+    lut[i] = i;
+  }
+  CHECK(dsi.queue_dcs_command(0xE0, lut.data(), lut.size()));
+  CHECK(dsi.get_queue_used() == 4 + 1 + lut.size() + 2);
+  CHECK(dsi.queue_generic_command(0xE1, lut.data(), lut.size()));
+  CHECK(dsi.flush_queue());
+  CHECK(dsi.get_queue_used() == 0);
+  CHECK(dsi.send_long_packet(MIPI_DSI_DCS_LONG_WRITE, lut.data(), lut.size()));
+
+  // Seul un paquet qui ne tient pas dans la file est refusé
+  std::vector<uint8_t> oversized(DSI_QUEUE_SIZE);
+  CHECK(!dsi.send_long_packet(MIPI_DSI_DCS_LONG_WRITE, oversized.data(), oversized.size()));
+}
+
+// Débit du CRC, à titre indicatif (mesuré auparavant au démarrage)
+static void report_crc_throughput() {
+  std::vector<uint8_t> data(1024 * 1024);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i * 7;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const uint16_t crc = dsi_crc16(data.data(), data.size());
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  printf("CRC-16 throughput: %.1f MB/s (0x%04X)\n", (float) data.size() / std::max<long>(elapsed.count(), 1), crc);
+}
+
+int main() {
+  test_header_ecc();
+  test_crc16();
+  test_packet_classes();
+  test_queue_long_packets();
+  report_crc_throughput();
+  return check_result("packet_test");
+}
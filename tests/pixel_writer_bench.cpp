@@ -0,0 +1,117 @@
+// Microbenchmark des writers de pixel de pixel_format.h : l'instanciation
+// choisie par select_pixel_writer() contre une écriture générique qui teste
+// format, inversion, ordre et tramage à chaque pixel. Les deux doivent
+// produire les mêmes octets ; seules les durées diffèrent.
+
+#include "check.h"
+#include "pixel_format.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::ili9881c;
+
+static const int WIDTH = 720;
+static const int HEIGHT = 1280;
+static const int RUNS = 8;
+
+struct WriterConfig {
+  PixelFormat format;
+  bool invert;
+  bool bgr;
+  bool dither;
+};
+
+// Écriture de référence, avec les branches par pixel qu'évite select_pixel_writer().
+// Hors ligne, comme l'appel virtuel draw_absolute_pixel_internal() qui la portait :
+// le compilateur ne peut pas sortir les tests de la boucle
+__attribute__((noinline)) static void write_pixel_generic(const WriterConfig &config, uint8_t *dst, int x, int y,
+                                                          Color color) {
+  uint8_t r = config.invert ? 255 - color.red : color.red;
+  uint8_t g = config.invert ? 255 - color.green : color.green;
+  uint8_t b = config.invert ? 255 - color.blue : color.blue;
+  if (config.bgr) {
+    std::swap(r, b);
+  }
+  if (config.format == PIXEL_FORMAT_RGB565) {
+    if (config.dither) {
+      uint8_t t = BAYER_4X4[y & 3][x & 3];
+      r = std::min(255, r + (t >> 1));
+      g = std::min(255, g + (t >> 2));
+      b = std::min(255, b + (t >> 1));
+    }
+    uint16_t v = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    dst[0] = v & 0xFF;
+    dst[1] = v >> 8;
+  } else if (config.format == PIXEL_FORMAT_RGB666) {
+    if (config.dither) {
+      uint8_t t = BAYER_4X4[y & 3][x & 3] >> 2;
+      r = std::min(255, r + t);
+      g = std::min(255, g + t);
+      b = std::min(255, b + t);
+    }
+    dst[0] = r & 0xFC;
+    dst[1] = g & 0xFC;
+    dst[2] = b & 0xFC;
+  } else {
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+  }
+}
+
+static Color pattern(int x, int y) { return Color(x & 0xFF, y & 0xFF, (x ^ y) & 0xFF); }
+
+template<typename F> static float time_frames(F &&frame) {
+  frame();  // mise en cache du buffer
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++) {
+    frame();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+  return (float) elapsed.count() / ((float) RUNS * WIDTH * HEIGHT);
+}
+
+static void run(const WriterConfig &config) {
+  const uint8_t bpp = bytes_per_pixel(config.format);
+  std::vector<uint8_t> generic(WIDTH * HEIGHT * bpp);
+  std::vector<uint8_t> specialised(WIDTH * HEIGHT * bpp);
+
+  // Configuration relue à travers volatile : pas de spécialisation par le compilateur
+  volatile WriterConfig opaque_config = config;
+  const WriterConfig runtime{opaque_config.format, opaque_config.invert, opaque_config.bgr, opaque_config.dither};
+  const float generic_ns = time_frames([&]() {
+    for (int y = 0; y < HEIGHT; y++) {
+      uint8_t *row = generic.data() + (size_t) y * WIDTH * bpp;
+      for (int x = 0; x < WIDTH; x++) {
+        write_pixel_generic(runtime, row + x * bpp, x, y, pattern(x, y));
+      }
+    }
+  });
+
+  const PixelWriteFn writer = select_pixel_writer(config.format, config.invert, config.bgr, config.dither);
+  const float specialised_ns = time_frames([&]() {
+    for (int y = 0; y < HEIGHT; y++) {
+      uint8_t *row = specialised.data() + (size_t) y * WIDTH * bpp;
+      for (int x = 0; x < WIDTH; x++) {
+        writer(row + x * bpp, x, y, pattern(x, y));
+      }
+    }
+  });
+
+  static const char *const FORMATS[] = {"rgb565", "rgb666", "rgb888"};
+  printf("  %-6s invert=%d bgr=%d dither=%d  generic %5.2f ns/px  specialised %5.2f ns/px\n", FORMATS[config.format],
+         config.invert, config.bgr, config.dither, generic_ns, specialised_ns);
+  CHECK(generic == specialised);
+}
+
+int main() {
+  printf("Pixel writer benchmark (%dx%d, %d frames):\n", WIDTH, HEIGHT, RUNS);
+  for (PixelFormat format : {PIXEL_FORMAT_RGB565, PIXEL_FORMAT_RGB666, PIXEL_FORMAT_RGB888}) {
+    for (int flags = 0; flags < 8; flags++) {
+      run({format, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0});
+    }
+  }
+  return check_result("pixel_writer_bench");
+}
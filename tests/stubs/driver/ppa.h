@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+typedef struct ppa_client_t *ppa_client_handle_t;
+typedef enum { PPA_OPERATION_SRM, PPA_OPERATION_BLEND, PPA_OPERATION_FILL } ppa_operation_t;
+typedef enum { PPA_SRM_ROTATION_ANGLE_0, PPA_SRM_ROTATION_ANGLE_90, PPA_SRM_ROTATION_ANGLE_180, PPA_SRM_ROTATION_ANGLE_270 } ppa_srm_rotation_angle_t;
+typedef enum { PPA_SRM_COLOR_MODE_ARGB8888, PPA_SRM_COLOR_MODE_RGB888, PPA_SRM_COLOR_MODE_RGB565 } ppa_srm_color_mode_t;
+typedef enum { PPA_BLEND_COLOR_MODE_ARGB8888, PPA_BLEND_COLOR_MODE_RGB888, PPA_BLEND_COLOR_MODE_RGB565, PPA_BLEND_COLOR_MODE_A8 } ppa_blend_color_mode_t;
+typedef enum { PPA_FILL_COLOR_MODE_ARGB8888, PPA_FILL_COLOR_MODE_RGB888, PPA_FILL_COLOR_MODE_RGB565 } ppa_fill_color_mode_t;
+typedef enum { PPA_TRANS_MODE_BLOCKING, PPA_TRANS_MODE_NON_BLOCKING } ppa_trans_mode_t;
+typedef enum { PPA_ALPHA_NO_CHANGE, PPA_ALPHA_FIX_VALUE, PPA_ALPHA_SCALE } ppa_alpha_update_mode_t;
+typedef struct { ppa_operation_t oper_type; uint32_t max_pending_trans_num; } ppa_client_config_t;
+typedef struct { const void *buffer; uint32_t pic_w; uint32_t pic_h; uint32_t block_w; uint32_t block_h; uint32_t block_offset_x; uint32_t block_offset_y; union { ppa_srm_color_mode_t srm_cm; ppa_blend_color_mode_t blend_cm; ppa_fill_color_mode_t fill_cm; }; } ppa_in_pic_blk_config_t;
+typedef struct { void *buffer; uint32_t buffer_size; uint32_t pic_w; uint32_t pic_h; uint32_t block_offset_x; uint32_t block_offset_y; union { ppa_srm_color_mode_t srm_cm; ppa_blend_color_mode_t blend_cm; ppa_fill_color_mode_t fill_cm; }; } ppa_out_pic_blk_config_t;
+typedef struct { ppa_in_pic_blk_config_t in; ppa_out_pic_blk_config_t out; ppa_srm_rotation_angle_t rotation_angle; float scale_x; float scale_y; bool mirror_x; bool mirror_y; bool rgb_swap; bool byte_swap; ppa_alpha_update_mode_t alpha_update_mode; ppa_trans_mode_t mode; void *user_data; } ppa_srm_oper_config_t;
+typedef union { struct { uint32_t b : 8; uint32_t g : 8; uint32_t r : 8; uint32_t a : 8; }; uint32_t val; } color_pixel_argb8888_data_t;
+typedef union { struct { uint8_t b, g, r; }; } color_pixel_rgb888_data_t;
+typedef struct { ppa_in_pic_blk_config_t in_bg; ppa_in_pic_blk_config_t in_fg; ppa_out_pic_blk_config_t out; bool bg_rgb_swap; bool bg_byte_swap; ppa_alpha_update_mode_t bg_alpha_update_mode; uint32_t bg_alpha_fix_val; bool fg_rgb_swap; bool fg_byte_swap; ppa_alpha_update_mode_t fg_alpha_update_mode; uint32_t fg_alpha_fix_val; color_pixel_rgb888_data_t fg_fix_rgb_val; bool bg_ck_en; color_pixel_rgb888_data_t bg_ck_rgb_low_thres; color_pixel_rgb888_data_t bg_ck_rgb_high_thres; bool fg_ck_en; color_pixel_rgb888_data_t fg_ck_rgb_low_thres; color_pixel_rgb888_data_t fg_ck_rgb_high_thres; color_pixel_rgb888_data_t ck_rgb_default_val; bool ck_reverse_bg2fg; ppa_trans_mode_t mode; void *user_data; } ppa_blend_oper_config_t;
+typedef struct { ppa_out_pic_blk_config_t out; uint32_t fill_block_w; uint32_t fill_block_h; color_pixel_argb8888_data_t fill_argb_color; ppa_trans_mode_t mode; void *user_data; } ppa_fill_oper_config_t;
+esp_err_t ppa_register_client(const ppa_client_config_t *config, ppa_client_handle_t *ret_client);
+esp_err_t ppa_do_scale_rotate_mirror(ppa_client_handle_t c, const ppa_srm_oper_config_t *config);
+esp_err_t ppa_do_blend(ppa_client_handle_t c, const ppa_blend_oper_config_t *config);
+esp_err_t ppa_do_fill(ppa_client_handle_t c, const ppa_fill_oper_config_t *config);
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/color.h"
+namespace esphome {
+namespace display {
+class Display;
+using display_writer_t = std::function<void(Display &)>;
+enum DisplayType { DISPLAY_TYPE_BINARY = 1, DISPLAY_TYPE_GRAYSCALE = 2, DISPLAY_TYPE_COLOR = 3 };
+enum DisplayRotation { DISPLAY_ROTATION_0_DEGREES = 0, DISPLAY_ROTATION_90_DEGREES = 90, DISPLAY_ROTATION_180_DEGREES = 180, DISPLAY_ROTATION_270_DEGREES = 270 };
+enum ColorOrder : uint8_t { COLOR_ORDER_RGB = 0, COLOR_ORDER_BGR = 1, COLOR_ORDER_GRB = 2 };
+enum ColorBitness : uint8_t { COLOR_BITNESS_888 = 0, COLOR_BITNESS_565 = 1, COLOR_BITNESS_332 = 2 };
+enum class TextAlign { TOP = 0x00, CENTER_VERTICAL = 0x01, BASELINE = 0x02, BOTTOM = 0x04, LEFT = 0x00, CENTER_HORIZONTAL = 0x08, RIGHT = 0x10, TOP_LEFT = 0, TOP_CENTER = 8, TOP_RIGHT = 16, CENTER_LEFT = 1, CENTER = 9, CENTER_RIGHT = 17, BASELINE_LEFT = 2, BASELINE_CENTER = 10, BASELINE_RIGHT = 18, BOTTOM_LEFT = 4, BOTTOM_CENTER = 12, BOTTOM_RIGHT = 20 };
+class Rect {
+ public:
+  int16_t x, y, w, h;
+  Rect();
+  Rect(int16_t x, int16_t y, int16_t w, int16_t h);
+  inline int16_t x2() { return this->x + this->w; }
+  inline int16_t y2() { return this->y + this->h; }
+  inline bool is_set() { return w > 0; }
+  bool inside(int16_t test_x, int16_t test_y, bool absolute = true);
+};
+class BaseFont {
+ public:
+  virtual void print(int x, int y, Display *display, Color color, const char *text, Color background) = 0;
+  virtual void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) = 0;
+};
+class Display : public PollingComponent {
+ public:
+  virtual void fill(Color color);
+  void clear();
+  virtual int get_width() { return this->get_width_internal(); }
+  virtual int get_height() { return this->get_height_internal(); }
+  inline void draw_pixel_at(int x, int y) { this->draw_pixel_at(x, y, COLOR_ON); }
+  virtual void draw_pixel_at(int x, int y, Color color) = 0;
+  virtual void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                              ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad);
+  void line(int x1, int y1, int x2, int y2, Color color = COLOR_ON);
+  void horizontal_line(int x, int y, int width, Color color = COLOR_ON);
+  void vertical_line(int x, int y, int height, Color color = COLOR_ON);
+  void rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON);
+  void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON);
+  void print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text, Color background = COLOR_OFF);
+  void print(int x, int y, BaseFont *font, Color color, const char *text, Color background = COLOR_OFF);
+  void printf(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, ...);
+  void set_writer(display_writer_t &&writer);
+  void set_rotation(DisplayRotation rotation);
+  void set_auto_clear(bool auto_clear_enabled) { this->auto_clear_enabled_ = auto_clear_enabled; }
+  DisplayRotation get_rotation() const { return this->rotation_; }
+  virtual DisplayType get_display_type() = 0;
+  void push_clipping(Rect rect);
+  void pop_clipping();
+  Rect get_clipping() const;
+  void start_clipping(Rect rect) { this->push_clipping(rect); }
+  void end_clipping() { this->pop_clipping(); }
+  void get_text_bounds(int x, int y, const char *text, BaseFont *font, TextAlign align, int *x1, int *y1, int *width, int *height);
+ protected:
+  virtual int get_width_internal() = 0;
+  virtual int get_height_internal() = 0;
+  void do_update_();
+  void clear_clipping_();
+  DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
+  optional<display_writer_t> writer_{};
+  bool auto_clear_enabled_{true};
+  std::vector<Rect> clipping_rectangle_;
+};
+}
+}
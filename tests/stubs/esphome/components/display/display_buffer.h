@@ -0,0 +1,14 @@
+#pragma once
+#include "display.h"
+namespace esphome { namespace display {
+class DisplayBuffer : public Display {
+ public:
+  int get_width() override;
+  int get_height() override;
+  void draw_pixel_at(int x, int y, Color color) override;
+ protected:
+  virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  void init_internal_(uint32_t buffer_length);
+  uint8_t *buffer_{nullptr};
+};
+} }
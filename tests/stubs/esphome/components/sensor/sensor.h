@@ -0,0 +1,2 @@
+#pragma once
+namespace esphome { namespace sensor { class Sensor { public: void publish_state(float s); }; } }
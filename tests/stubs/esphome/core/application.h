@@ -0,0 +1,2 @@
+#pragma once
+namespace esphome { class Application { public: void feed_wdt(); }; extern Application App; }
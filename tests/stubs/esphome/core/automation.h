@@ -0,0 +1,4 @@
+#pragma once
+namespace esphome {
+template<typename... Ts> class Trigger { public: void trigger(Ts... x) {} };
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+namespace esphome {
+struct Color {
+  union { struct { uint8_t r, g, b, w; }; struct { uint8_t red, green, blue, white; }; uint32_t raw_32; };
+  Color() : raw_32(0) {}
+  Color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) : r(r), g(g), b(b), w(w) {}
+  bool operator==(const Color &o) const { return raw_32 == o.raw_32; }
+  bool operator!=(const Color &o) const { return raw_32 != o.raw_32; }
+  static Color gradient(const Color &a, const Color &b, uint8_t amnt);
+};
+static const Color COLOR_OFF(0, 0, 0, 0);
+static const Color COLOR_ON(255, 255, 255, 255);
+}
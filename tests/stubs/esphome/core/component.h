@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+namespace esphome {
+namespace setup_priority { extern const float HARDWARE; extern const float PROCESSOR; }
+class Component {
+ public:
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return 0; }
+  void mark_failed();
+  bool is_failed() const;
+  bool is_ready() const;
+  void status_set_warning(const char *msg = "");
+  void status_clear_warning();
+ protected:
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+  void set_interval(uint32_t interval, std::function<void()> &&f);
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+  bool cancel_interval(const std::string &name);
+  bool cancel_timeout(const std::string &name);
+};
+class PollingComponent : public Component {
+ public:
+  virtual void update() = 0;
+  virtual void set_update_interval(uint32_t update_interval);
+  virtual uint32_t get_update_interval() const;
+  void start_poller();
+  void stop_poller();
+};
+}
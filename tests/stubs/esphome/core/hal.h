@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+#define HOT
+namespace esphome {
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t millis();
+uint32_t micros();
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <functional>
+#include <vector>
+namespace esphome {
+template<typename T> class optional {
+ public:
+  optional() {}
+  optional(T v) : v_(v), has_(true) {}
+  bool has_value() const { return has_; }
+  T &value() { return v_; }
+  T &operator*() { return v_; }
+ private:
+  T v_{}; bool has_{false};
+};
+template<class T> class RAMAllocator {
+ public:
+  enum { NONE = 0, ALLOC_EXTERNAL = 1, ALLOC_INTERNAL = 2 };
+  RAMAllocator(uint8_t flags = 0) {}
+  T *allocate(size_t n) { return static_cast<T *>(malloc(n * sizeof(T))); }
+  void deallocate(T *p, size_t n) { free(p); }
+};
+template<typename... X> class CallbackManager;
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&callback) { cbs_.push_back(std::move(callback)); }
+  void call(Ts... args) { for (auto &cb : cbs_) cb(args...); }
+  size_t size() const { return cbs_.size(); }
+ private:
+  std::vector<std::function<void(Ts...)>> cbs_;
+};
+class HighFrequencyLoopRequester {
+ public:
+  void start();
+  void stop();
+};
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdio>
+namespace esphome { void esp_log_stub(const char *tag, const char *fmt, ...) __attribute__((format(printf, 2, 3))); }
+// Les niveaux debug et verbose restent vérifiés à la compilation mais ne
+// s'affichent qu'avec HOST_LOG_VERBOSE, pour ne pas fausser les mesures
+#ifdef HOST_LOG_VERBOSE
+#define ESP_LOG_QUIET_(tag, ...) ::esphome::esp_log_stub(tag, __VA_ARGS__)
+#else
+#define ESP_LOG_QUIET_(tag, ...) do { if (0) ::esphome::esp_log_stub(tag, __VA_ARGS__); } while (0)
+#endif
+#define ESP_LOGE(tag, ...) ::esphome::esp_log_stub(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ::esphome::esp_log_stub(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ::esphome::esp_log_stub(tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ESP_LOG_QUIET_(tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ESP_LOG_QUIET_(tag, __VA_ARGS__)
+#define ESP_LOGVV(tag, ...) ESP_LOG_QUIET_(tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ESP_LOG_QUIET_(tag, __VA_ARGS__)
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define LOG_PIN(prefix, pin) do {} while (0)
+#define LOG_SENSOR(prefix, type, obj) do {} while (0)
@@ -0,0 +1,5 @@
+#pragma once
+// Capacités de l'ESP32-P4 simulées sur l'hôte : le PPA est déclaré mais son
+// enregistrement échoue, ce qui force les chemins CPU
+#define SOC_MIPI_DSI_SUPPORTED 1
+#define SOC_PPA_SUPPORTED 1
@@ -0,0 +1,436 @@
+// Implémentations minimales des API ESP-IDF, FreeRTOS et ESPHome utilisées par
+// les composants, pour compiler et exécuter leurs chemins de rendu sur l'hôte.
+// Le panel DPI est simulé par des framebuffers en RAM ; les tâches, files et
+// le PPA sont indisponibles, ce qui force les chemins synchrones et CPU.
+
+#include "driver/ppa.h"
+#include "esp_cache.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_lcd_mipi_dsi.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+#include <thread>
+
+// ---- ESP-IDF : mémoire et cache ----
+
+const char *esp_err_to_name(esp_err_t err) {
+  switch (err) {
+    case ESP_OK:
+      return "ESP_OK";
+    case ESP_ERR_TIMEOUT:
+      return "ESP_ERR_TIMEOUT";
+    default:
+      return "ESP_FAIL";
+  }
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+  void *ptr = nullptr;
+  if (alignment < sizeof(void *)) {
+    alignment = sizeof(void *);
+  }
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    return nullptr;
+  }
+  return ptr;
+}
+
+void *heap_caps_aligned_calloc(size_t alignment, size_t n, size_t size, uint32_t caps) {
+  void *ptr = heap_caps_aligned_alloc(alignment, n * size, caps);
+  if (ptr != nullptr) {
+    memset(ptr, 0, n * size);
+  }
+  return ptr;
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) { return malloc(size); }
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) { return calloc(n, size); }
+void heap_caps_free(void *ptr) { free(ptr); }
+size_t heap_caps_get_free_size(uint32_t caps) { return 32 * 1024 * 1024; }
+
+esp_err_t esp_cache_msync(void *addr, size_t size, int flags) { return ESP_OK; }
+
+// ---- ESP-IDF : bus DSI et panel DPI simulés ----
+
+struct esp_lcd_dsi_bus_t {
+  int unused;
+};
+struct esp_lcd_panel_io_t {
+  int unused;
+};
+struct esp_lcd_panel_t {
+  uint32_t width;
+  uint32_t height;
+  uint8_t bytes_per_pixel;
+  uint8_t num_fbs;
+  uint8_t *fbs[3];
+  uint8_t *current;
+};
+
+esp_err_t esp_lcd_new_dsi_bus(const esp_lcd_dsi_bus_config_t *bus_config, esp_lcd_dsi_bus_handle_t *ret_bus) {
+  *ret_bus = new esp_lcd_dsi_bus_t{};
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_del_dsi_bus(esp_lcd_dsi_bus_handle_t bus) {
+  delete bus;
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_new_panel_io_dbi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dbi_io_config_t *io_config,
+                                   esp_lcd_panel_io_handle_t *ret_io) {
+  *ret_io = new esp_lcd_panel_io_t{};
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_new_panel_dpi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dpi_panel_config_t *panel_config,
+                                esp_lcd_panel_handle_t *ret_panel) {
+  auto *panel = new esp_lcd_panel_t{};
+  panel->width = panel_config->video_timing.h_size;
+  panel->height = panel_config->video_timing.v_size;
+  // Format d'entrée (IDF >= 5.5) prioritaire sur l'ancien champ pixel_format
+  const int format = panel_config->in_color_format != 0 ? (int) panel_config->in_color_format
+                                                       : (int) panel_config->pixel_format;
+  panel->bytes_per_pixel = format == LCD_COLOR_FMT_RGB565 ? 2 : 3;
+  panel->num_fbs = panel_config->num_fbs == 0 ? 1 : std::min<uint8_t>(panel_config->num_fbs, 3);
+  const size_t size = (size_t) panel->width * panel->height * panel->bytes_per_pixel;
+  for (uint8_t i = 0; i < panel->num_fbs; i++) {
+    panel->fbs[i] = (uint8_t *) heap_caps_aligned_calloc(64, 1, size, MALLOC_CAP_SPIRAM);
+  }
+  panel->current = panel->fbs[0];
+  *ret_panel = panel;
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_dpi_panel_get_frame_buffer(esp_lcd_panel_handle_t dpi_panel, uint32_t fb_num, void **fb0, ...) {
+  if (fb_num == 0 || fb_num > dpi_panel->num_fbs) {
+    return ESP_FAIL;
+  }
+  *fb0 = dpi_panel->fbs[0];
+  va_list args;
+  va_start(args, fb0);
+  for (uint32_t i = 1; i < fb_num; i++) {
+    void **fb = va_arg(args, void **);
+    *fb = dpi_panel->fbs[i];
+  }
+  va_end(args);
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_dpi_panel_register_event_callbacks(esp_lcd_panel_handle_t dpi_panel,
+                                                     const esp_lcd_dpi_panel_event_callbacks_t *cbs, void *user_ctx) {
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_io_tx_param(esp_lcd_panel_io_handle_t io, int lcd_cmd, const void *param, size_t param_size) {
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_io_rx_param(esp_lcd_panel_io_handle_t io, int lcd_cmd, void *param, size_t param_size) {
+  memset(param, 0, param_size);
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_init(esp_lcd_panel_handle_t panel) { return ESP_OK; }
+esp_err_t esp_lcd_panel_reset(esp_lcd_panel_handle_t panel) { return ESP_OK; }
+esp_err_t esp_lcd_panel_disp_on_off(esp_lcd_panel_handle_t panel, bool on_off) { return ESP_OK; }
+
+esp_err_t esp_lcd_panel_draw_bitmap(esp_lcd_panel_handle_t panel, int x_start, int y_start, int x_end, int y_end,
+                                    const void *color_data) {
+  // Comme le driver DPI : un framebuffer du panel est affiché tel quel, tout
+  // autre buffer est copié dans le framebuffer courant
+  const size_t size = (size_t) panel->width * panel->height * panel->bytes_per_pixel;
+  const auto *src = (const uint8_t *) color_data;
+  for (uint8_t i = 0; i < panel->num_fbs; i++) {
+    if (src >= panel->fbs[i] && src < panel->fbs[i] + size) {
+      panel->current = panel->fbs[i];
+      return ESP_OK;
+    }
+  }
+  const size_t row = (size_t) (x_end - x_start) * panel->bytes_per_pixel;
+  for (int y = y_start; y < y_end; y++) {
+    memcpy(panel->current + ((size_t) y * panel->width + x_start) * panel->bytes_per_pixel, src, row);
+    src += row;
+  }
+  return ESP_OK;
+}
+
+// ---- PPA : indisponible sur l'hôte ----
+
+esp_err_t ppa_register_client(const ppa_client_config_t *config, ppa_client_handle_t *ret_client) { return ESP_FAIL; }
+esp_err_t ppa_do_scale_rotate_mirror(ppa_client_handle_t c, const ppa_srm_oper_config_t *config) { return ESP_FAIL; }
+esp_err_t ppa_do_blend(ppa_client_handle_t c, const ppa_blend_oper_config_t *config) { return ESP_FAIL; }
+esp_err_t ppa_do_fill(ppa_client_handle_t c, const ppa_fill_oper_config_t *config) { return ESP_FAIL; }
+
+// ---- FreeRTOS : pas d'ordonnanceur, les appelants repassent en synchrone ----
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t size) { return nullptr; }
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) { return pdFALSE; }
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) { return pdFALSE; }
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken) { return pdFALSE; }
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) { return 0; }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return nullptr; }
+SemaphoreHandle_t xSemaphoreCreateMutex() { return nullptr; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t t) { return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return pdTRUE; }
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t *woken) { return pdTRUE; }
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t f, const char *name, uint32_t stack, void *arg, UBaseType_t prio,
+                                   TaskHandle_t *h, BaseType_t core) {
+  return pdFALSE;
+}
+void vTaskDelay(TickType_t t) { esphome::delay(t); }
+void vTaskDelete(TaskHandle_t t) {}
+TickType_t xTaskGetTickCount() { return esphome::millis(); }
+BaseType_t xTaskNotifyGive(TaskHandle_t t) { return pdTRUE; }
+void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t *woken) {}
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) { return 1; }
+
+namespace esphome {
+
+// ---- Noyau ESPHome ----
+
+static const auto START = std::chrono::steady_clock::now();
+
+uint32_t millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+uint32_t micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+void esp_log_stub(const char *tag, const char *fmt, ...) {
+  printf("[%s] ", tag);
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf("\n");
+}
+
+namespace setup_priority {
+const float HARDWARE = 800.0f;
+const float PROCESSOR = 400.0f;
+}  // namespace setup_priority
+
+Application App;
+void Application::feed_wdt() {}
+
+// État d'échec partagé : les tests n'instancient qu'un composant à la fois
+static bool component_failed = false;
+
+void Component::mark_failed() { component_failed = true; }
+bool Component::is_failed() const { return component_failed; }
+bool Component::is_ready() const { return !component_failed; }
+void Component::status_set_warning(const char *msg) {}
+void Component::status_clear_warning() {}
+void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {}
+void Component::set_interval(uint32_t interval, std::function<void()> &&f) {}
+void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {}
+bool Component::cancel_interval(const std::string &name) { return true; }
+bool Component::cancel_timeout(const std::string &name) { return true; }
+
+void PollingComponent::set_update_interval(uint32_t update_interval) {}
+uint32_t PollingComponent::get_update_interval() const { return 1000; }
+void PollingComponent::start_poller() {}
+void PollingComponent::stop_poller() {}
+
+void HighFrequencyLoopRequester::start() {}
+void HighFrequencyLoopRequester::stop() {}
+
+namespace sensor {
+void Sensor::publish_state(float state) {}
+}  // namespace sensor
+
+// ---- Display : versions simplifiées des implémentations ESPHome ----
+
+namespace display {
+
+Rect::Rect() : x(0), y(0), w(0), h(0) {}
+Rect::Rect(int16_t x, int16_t y, int16_t w, int16_t h) : x(x), y(y), w(w), h(h) {}
+
+bool Rect::inside(int16_t test_x, int16_t test_y, bool absolute) {
+  if (!this->is_set()) {
+    return true;
+  }
+  return test_x >= this->x && test_x < this->x2() && test_y >= this->y && test_y < this->y2();
+}
+
+void Display::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
+void Display::clear() { this->fill(COLOR_OFF); }
+
+void Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                             ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  const size_t line_stride = x_offset + w + x_pad;
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      const size_t index = (y + y_offset) * line_stride + x + x_offset;
+      Color color;
+      if (bitness == COLOR_BITNESS_565) {
+        const uint8_t *p = ptr + index * 2;
+        const uint16_t v = big_endian ? (p[0] << 8) | p[1] : (p[1] << 8) | p[0];
+        color = Color((v >> 8) & 0xF8, (v >> 3) & 0xFC, (v << 3) & 0xF8);
+      } else if (bitness == COLOR_BITNESS_888) {
+        const uint8_t *p = ptr + index * 3;
+        color = Color(p[0], p[1], p[2]);
+      } else {
+        const uint8_t v = ptr[index];
+        color = Color(v & 0xE0, (v << 3) & 0xE0, (v << 6) & 0xC0);
+      }
+      this->draw_pixel_at(x_start + x, y_start + y, color);
+    }
+  }
+}
+
+void Display::line(int x1, int y1, int x2, int y2, Color color) {
+  const int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+  const int dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+  int err = dx + dy;
+  while (true) {
+    this->draw_pixel_at(x1, y1, color);
+    if (x1 == x2 && y1 == y2) {
+      break;
+    }
+    const int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x1 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y1 += sy;
+    }
+  }
+}
+
+void Display::horizontal_line(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++) {
+    this->draw_pixel_at(i, y, color);
+  }
+}
+
+void Display::vertical_line(int x, int y, int height, Color color) {
+  for (int i = y; i < y + height; i++) {
+    this->draw_pixel_at(x, i, color);
+  }
+}
+
+void Display::rectangle(int x1, int y1, int width, int height, Color color) {
+  this->horizontal_line(x1, y1, width, color);
+  this->horizontal_line(x1, y1 + height - 1, width, color);
+  this->vertical_line(x1, y1, height, color);
+  this->vertical_line(x1 + width - 1, y1, height, color);
+}
+
+void Display::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  for (int i = y1; i < y1 + height; i++) {
+    this->horizontal_line(x1, i, width, color);
+  }
+}
+
+void Display::print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text, Color background) {
+  int x_start, y_start, width, height;
+  this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+  font->print(x_start, y_start, this, color, text, background);
+}
+
+void Display::print(int x, int y, BaseFont *font, Color color, const char *text, Color background) {
+  this->print(x, y, font, color, TextAlign::TOP_LEFT, text, background);
+}
+
+void Display::printf(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  this->print(x, y, font, color, align, buffer);
+}
+
+void Display::get_text_bounds(int x, int y, const char *text, BaseFont *font, TextAlign align, int *x1, int *y1,
+                              int *width, int *height) {
+  int x_offset, baseline;
+  font->measure(text, width, &x_offset, &baseline, height);
+  const auto bits = static_cast<int>(align);
+  if (bits & static_cast<int>(TextAlign::CENTER_HORIZONTAL)) {
+    *x1 = x - *width / 2;
+  } else if (bits & static_cast<int>(TextAlign::RIGHT)) {
+    *x1 = x - *width;
+  } else {
+    *x1 = x;
+  }
+  if (bits & static_cast<int>(TextAlign::CENTER_VERTICAL)) {
+    *y1 = y - *height / 2;
+  } else if (bits & static_cast<int>(TextAlign::BASELINE)) {
+    *y1 = y - baseline;
+  } else if (bits & static_cast<int>(TextAlign::BOTTOM)) {
+    *y1 = y - *height;
+  } else {
+    *y1 = y;
+  }
+}
+
+void Display::set_writer(display_writer_t &&writer) { this->writer_ = writer; }
+void Display::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
+
+void Display::push_clipping(Rect rect) { this->clipping_rectangle_.push_back(rect); }
+
+void Display::pop_clipping() {
+  if (!this->clipping_rectangle_.empty()) {
+    this->clipping_rectangle_.pop_back();
+  }
+}
+
+Rect Display::get_clipping() const {
+  if (this->clipping_rectangle_.empty()) {
+    return Rect();
+  }
+  return this->clipping_rectangle_.back();
+}
+
+void Display::clear_clipping_() { this->clipping_rectangle_.clear(); }
+
+void Display::do_update_() {
+  if (this->auto_clear_enabled_) {
+    this->clear();
+  }
+  if (this->writer_.has_value()) {
+    (*this->writer_)(*this);
+  }
+  this->clear_clipping_();
+}
+
+int DisplayBuffer::get_width() { return this->get_width_internal(); }
+int DisplayBuffer::get_height() { return this->get_height_internal(); }
+
+void DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+  if (!this->get_clipping().inside(x, y)) {
+    return;
+  }
+  this->draw_absolute_pixel_internal(x, y, color);
+}
+
+void DisplayBuffer::init_internal_(uint32_t buffer_length) {
+  this->buffer_ = (uint8_t *) heap_caps_calloc(1, buffer_length, MALLOC_CAP_SPIRAM);
+}
+
+}  // namespace display
+}  // namespace esphome